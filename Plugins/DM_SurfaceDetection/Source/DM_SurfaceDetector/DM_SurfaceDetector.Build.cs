@@ -14,15 +14,23 @@ public class DM_SurfaceDetector : ModuleRules
 				"Core",
 				"CoreUObject",
 				"Engine",
-				"PhysicsCore"
+				"PhysicsCore",
+				"AudioExtensions",
+				"DeveloperSettings"
 			}
 		);
 
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				// Add private dependencies here if needed
+				"MetasoundGraphCore",
+				"MetasoundFrontend",
+				"MetasoundEngine",
+				"AudioMixer"
 			}
 		);
+
+		// Adds the GameplayDebugger dependency and WITH_GAMEPLAY_DEBUGGER where the debugger is available
+		SetupGameplayDebuggerSupport(Target);
 	}
 }
@@ -0,0 +1,155 @@
+#include "AnimNotify_DemuteFootstep.h"
+#include "DemuteFootstepCsvStats.h"
+#include "DemuteFootstepTimingData.h"
+#include "DemuteProceduralFootstepComponent.h"
+#include "DemuteSurfaceSubsystem.h"
+#include "DemuteSurfaceSettings.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+
+void UAnimNotify_DemuteFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+    Super::Notify(MeshComp, Animation, EventReference);
+
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Total);
+
+    if (!MeshComp || !Metasound)
+    {
+        return;
+    }
+
+    UWorld* World = MeshComp->GetWorld();
+    UDemuteSurfaceSubsystem* SurfaceSubsystem = World ? World->GetSubsystem<UDemuteSurfaceSubsystem>() : nullptr;
+    if (!SurfaceSubsystem)
+    {
+        return;
+    }
+
+    // Keeps procedural footsteps in phase, and leaves them the footstep while they are generated
+    if (UDemuteProceduralFootstepComponent* ProceduralFootsteps = MeshComp->GetOwner() ? MeshComp->GetOwner()->FindComponentByClass<UDemuteProceduralFootstepComponent>() : nullptr)
+    {
+        if (!ProceduralFootsteps->NotifyAnimFootstep(SocketName))
+        {
+            return;
+        }
+    }
+
+    const FVector Start = SocketName.IsNone() ? MeshComp->GetComponentLocation() : MeshComp->GetSocketLocation(SocketName);
+
+    // Per-platform defaults from the project settings, unless this notify overrides them
+    const FDemuteSurfacePerformancePolicy& Policy = UDemuteSurfaceSettings::Get()->GetPolicy();
+
+    FDemuteFootstepRequest Request;
+    Request.Instigator = MeshComp->GetOwner();
+    Request.Foot = SocketName;
+    Request.Start = Start;
+    Request.End = Start - FVector(0.0f, 0.0f, bUseProjectTraceSettings ? Policy.TraceLength : TraceLength);
+    Request.TraceChannel = bUseProjectTraceSettings ? Policy.TraceChannel : TraceChannel;
+    Request.bTraceComplex = bUseProjectTraceSettings ? Policy.bTraceComplex : bTraceComplex;
+    Request.SurfaceData = AudioSurfaceData;
+    Request.Sound = Metasound;
+    Request.SurfaceParameterName = SurfaceParameterName;
+    Request.Significance = Significance;
+    Request.bAllowCrowdAggregation = bAllowCrowdAggregation;
+    Request.CrowdSound = CrowdSound;
+
+    SurfaceSubsystem->RequestFootstep(Request);
+
+    if (bPredictNextFootstep && SurfaceSubsystem->bPredictFootsteps && Animation)
+    {
+        PredictNextFootstep(MeshComp, Animation, EventReference, *SurfaceSubsystem, Policy);
+    }
+}
+
+void UAnimNotify_DemuteFootstep::PredictNextFootstep(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference,
+    UDemuteSurfaceSubsystem& SurfaceSubsystem, const FDemuteSurfacePerformancePolicy& Policy) const
+{
+    const FAnimNotifyEvent* CurrentEvent = EventReference.GetNotify();
+    const float PlayLength = Animation->GetPlayLength();
+    if (!CurrentEvent || PlayLength <= 0.0f)
+    {
+        return;
+    }
+
+    // Contacts generated by the Audio Animation Tools give the next foot without scanning the notifies. Its footstep is
+    // traced and played like this one. Contacts within the tolerance of this one are this contact.
+    static constexpr float ContactTimeTolerance = 0.001f;
+    const UAnimNotify_DemuteFootstep* NextFootstep = nullptr;
+    FName NextSocketName;
+    float TimeToNext = TNumericLimits<float>::Max();
+
+    FDemuteFootstepContact NextContact;
+    const UDemuteFootstepTimingData* TimingData = UDemuteFootstepTimingData::Find(Animation);
+    if (TimingData && TimingData->GetNextContact(CurrentEvent->GetTriggerTime() + ContactTimeTolerance, true, NextContact, TimeToNext))
+    {
+        NextFootstep = this;
+        NextSocketName = NextContact.Foot;
+        TimeToNext += ContactTimeTolerance;
+    }
+    else
+    {
+        // Next Demute footstep of the asset, wrapping around for looping locomotion (a single footstep predicts itself)
+        for (const FAnimNotifyEvent& Event : Animation->Notifies)
+        {
+            const UAnimNotify_DemuteFootstep* Footstep = Cast<UAnimNotify_DemuteFootstep>(Event.Notify);
+            if (!Footstep)
+            {
+                continue;
+            }
+
+            float Delta = Event.GetTriggerTime() - CurrentEvent->GetTriggerTime();
+            if (Delta <= 0.0f)
+            {
+                Delta += PlayLength;
+            }
+
+            if (Delta < TimeToNext)
+            {
+                TimeToNext = Delta;
+                NextFootstep = Footstep;
+                NextSocketName = Footstep->SocketName;
+            }
+        }
+    }
+
+    if (!NextFootstep)
+    {
+        return;
+    }
+
+    // Montages report their rate. Sequence players and blend spaces do not expose theirs to notifies,
+    // so it is measured from the previous footstep, and the first footstep of an animation predicts nothing.
+    float PlayRate = SurfaceSubsystem.MeasureFootstepPlayRate(MeshComp, Animation, CurrentEvent->GetTriggerTime());
+    if (const UAnimMontage* Montage = Cast<UAnimMontage>(Animation))
+    {
+        const UAnimInstance* AnimInstance = MeshComp->GetAnimInstance();
+        if (AnimInstance && AnimInstance->Montage_IsPlaying(Montage))
+        {
+            PlayRate = Montage->RateScale * AnimInstance->Montage_GetPlayRate(Montage);
+        }
+    }
+
+    if (PlayRate <= 0.0f)
+    {
+        return;
+    }
+
+    const bool bProjectTrace = NextFootstep->bUseProjectTraceSettings;
+    SurfaceSubsystem.PredictFootstep(
+        MeshComp,
+        NextSocketName,
+        bProjectTrace ? Policy.TraceLength : NextFootstep->TraceLength,
+        bProjectTrace ? Policy.TraceChannel : NextFootstep->TraceChannel,
+        bProjectTrace ? Policy.bTraceComplex : NextFootstep->bTraceComplex,
+        NextFootstep->AudioSurfaceData,
+        NextFootstep->Metasound,
+        TimeToNext / PlayRate
+    );
+}
+
+FString UAnimNotify_DemuteFootstep::GetNotifyName_Implementation() const
+{
+    return SocketName.IsNone() ? TEXT("Demute Footstep") : FString::Printf(TEXT("Demute Footstep (%s)"), *SocketName.ToString());
+}
@@ -16,6 +16,17 @@ int32 UAudioSurfaceData::GetMetasoundParameter(TEnumAsByte<EPhysicalSurface> Sur
     return -1;
 }
 
+float UAudioSurfaceData::GetSurfaceLoudness(TEnumAsByte<EPhysicalSurface> SurfaceType) const
+{
+    const float* FoundValue = SurfaceLoudnessMap.Find(SurfaceType);
+    if (FoundValue)
+    {
+        return *FoundValue;
+    }
+
+    return 1.0f;
+}
+
 #if WITH_EDITOR
 void UAudioSurfaceData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
@@ -1,18 +1,44 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "DM_SurfaceDetector.h"
+#include "MetasoundFrontendRegistries.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "GameplayDebuggerCategory_DemuteFootsteps.h"
+#endif
 
 #define LOCTEXT_NAMESPACE "FDM_SurfaceDetectorModule"
 
 void FDM_SurfaceDetectorModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Register the native MetaSound nodes declared in this module (Surface Wave Selector, ...)
+	FMetasoundFrontendRegistryContainer::Get()->RegisterPendingNodes();
+
+#if WITH_GAMEPLAY_DEBUGGER
+	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+	GameplayDebuggerModule.RegisterCategory("DemuteFootsteps",
+		IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_DemuteFootsteps::MakeInstance),
+		EGameplayDebuggerCategoryState::EnabledInGameAndSimulate);
+	GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
 }
 
 void FDM_SurfaceDetectorModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+#if WITH_GAMEPLAY_DEBUGGER
+	if (IGameplayDebugger::IsAvailable())
+	{
+		IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+		GameplayDebuggerModule.UnregisterCategory("DemuteFootsteps");
+		GameplayDebuggerModule.NotifyCategoriesChanged();
+	}
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -1,6 +1,13 @@
 #include "DemuteAudioFunctionLibrary.h"
+#include "DemuteGroundProbeComponent.h"
+#include "DemuteSurfaceSubsystem.h"
+#include "DemuteSurfaceQueryRecorder.h"
+#include "DemuteFootstepCsvStats.h"
 #include "Components/PrimitiveComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
 #include "Materials/MaterialInterface.h"
+#include "Misc/ScopeExit.h"
 
 bool UDemuteAudioFunctionLibrary::LineTraceForSurfaceTypes(
     UObject* WorldContextObject,
@@ -16,9 +23,25 @@ bool UDemuteAudioFunctionLibrary::LineTraceForSurfaceTypes(
     OutMetasoundParameter = -1;
     OutSurfaceType = SurfaceType_Default;
 
-    // Perform the line trace
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, SurfaceQuery);
+    CSV_CUSTOM_STAT(DemuteFootsteps, Traces, 1, ECsvCustomStatOp::Accumulate);
+
+    // Record the query for DEMUTE.Debug.DrawSurfaceQueries and DEMUTE.Record, whichever way this function returns
+    const bool bRecordQuery = FDemuteSurfaceQueryHistory::IsRecording() || FDemuteSurfaceQueryRecorder::IsRecording();
+    const uint64 StartCycles = bRecordQuery ? FPlatformTime::Cycles64() : 0;
     FHitResult HitResult;
-    bool bHit = UKismetSystemLibrary::LineTraceSingle(
+    bool bHit = false;
+    ON_SCOPE_EXIT
+    {
+        if (bRecordQuery)
+        {
+            RecordSurfaceQuery(WorldContextObject, Start, End, TraceChannel, bTraceComplex, ActorsToIgnore.Num() > 0 ? ActorsToIgnore[0] : nullptr,
+                SurfaceData, bHit ? &HitResult : nullptr, OutMetasoundParameter, OutSurfaceType, StartCycles);
+        }
+    };
+
+    // Perform the line trace
+    bHit = UKismetSystemLibrary::LineTraceSingle(
         WorldContextObject,
         Start,
         End,
@@ -35,6 +58,24 @@ bool UDemuteAudioFunctionLibrary::LineTraceForSurfaceTypes(
         return false;
     }
 
+    return GetSurfaceTypeFromHit(HitResult, bTraceComplex, SurfaceData, OutMetasoundParameter, OutSurfaceType);
+}
+
+bool UDemuteAudioFunctionLibrary::GetSurfaceTypeFromHit(
+    const FHitResult& HitResult,
+    bool bTraceComplex,
+    UAudioSurfaceData* SurfaceData,
+    int32& OutMetasoundParameter,
+    TEnumAsByte<EPhysicalSurface>& OutSurfaceType)
+{
+    OutMetasoundParameter = -1;
+    OutSurfaceType = SurfaceType_Default;
+
+    if (!HitResult.GetComponent())
+    {
+        return false;
+    }
+
     UPrimitiveComponent* Component = HitResult.GetComponent();
     int32 NumMaterials = Component->GetNumMaterials();
     
@@ -46,6 +87,11 @@ bool UDemuteAudioFunctionLibrary::LineTraceForSurfaceTypes(
 
     if (bTraceComplex)
     { 
+        if (!HitResult.PhysMaterial.IsValid())
+        {
+            return false;
+        }
+
         TEnumAsByte<EPhysicalSurface> SurfaceType = HitResult.PhysMaterial->SurfaceType;
         OutMetasoundParameter = SurfaceType.GetValue();
         OutSurfaceType = SurfaceType;
@@ -122,6 +168,74 @@ bool UDemuteAudioFunctionLibrary::LineTraceForSurfaceTypes(
     }
 }
 
+void UDemuteAudioFunctionLibrary::RecordSurfaceQuery(
+    UObject* WorldContextObject,
+    const FVector& Start,
+    const FVector& End,
+    ETraceTypeQuery TraceChannel,
+    bool bTraceComplex,
+    const AActor* QueryingActor,
+    const UAudioSurfaceData* SurfaceData,
+    const FHitResult* HitResult,
+    int32 MetasoundParameter,
+    TEnumAsByte<EPhysicalSurface> SurfaceType,
+    uint64 StartCycles)
+{
+    if (!FDemuteSurfaceQueryHistory::IsRecording() && !FDemuteSurfaceQueryRecorder::IsRecording())
+    {
+        return;
+    }
+
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    const bool bHit = HitResult != nullptr;
+    const bool bFoundSurface = MetasoundParameter >= 0;
+
+    if (FDemuteSurfaceQueryRecorder::IsRecording())
+    {
+        FDemuteSurfaceQueryRecorder::Get().Record(World ? World->GetTimeSeconds() : 0.0, Start, End, TraceChannel, bTraceComplex,
+            QueryingActor ? QueryingActor->GetClass() : nullptr, SurfaceData, bHit, bFoundSurface, MetasoundParameter, SurfaceType);
+    }
+
+    UDemuteSurfaceSubsystem* SurfaceSubsystem = World ? World->GetSubsystem<UDemuteSurfaceSubsystem>() : nullptr;
+    if (!SurfaceSubsystem || !FDemuteSurfaceQueryHistory::IsRecording())
+    {
+        return;
+    }
+
+    FDemuteSurfaceQueryRecord Record;
+    Record.Start = Start;
+    Record.End = End;
+    Record.HitLocation = bHit ? HitResult->ImpactPoint : End;
+    Record.SurfaceType = SurfaceType;
+    Record.bHit = bHit;
+    Record.bFoundSurface = bFoundSurface;
+    Record.CostMicroseconds = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+    SurfaceSubsystem->GetQueryHistory().Add(Record);
+}
+
+bool UDemuteAudioFunctionLibrary::GroundProbeForSurfaceTypes(
+    UDemuteGroundProbeComponent* GroundProbe,
+    UAudioSurfaceData* SurfaceData,
+    int32& OutMetasoundParameter,
+    TEnumAsByte<EPhysicalSurface>& OutSurfaceType)
+{
+    OutMetasoundParameter = -1;
+    OutSurfaceType = SurfaceType_Default;
+
+    if (!GroundProbe)
+    {
+        return false;
+    }
+
+    const FDemuteGroundHit& Ground = GroundProbe->GetGround();
+    if (!Ground.bHit)
+    {
+        return false;
+    }
+
+    return GetSurfaceTypeFromHit(Ground.Hit, GroundProbe->bTraceComplex, SurfaceData, OutMetasoundParameter, OutSurfaceType);
+}
+
 UPhysicalMaterial* UDemuteAudioFunctionLibrary::GetPhysicalMaterialFromMaterial(UMaterialInterface* Material)
 {
     if (!Material)
@@ -0,0 +1,88 @@
+#include "DemuteAudioParameterBatch.h"
+#include "ActiveSound.h"
+#include "AudioDevice.h"
+#include "AudioThread.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+
+void FDemuteAudioParameterBatch::Add(UAudioComponent* AudioComponent, FAudioParameter&& Parameter)
+{
+    if (!AudioComponent)
+    {
+        return;
+    }
+
+    TArray<FAudioParameter>& Parameters = PendingParameters.FindOrAdd(AudioComponent);
+
+    // Triggers are events, every one of them counts. Other parameters only keep their last value.
+    if (Parameter.ParamType != EAudioParameterType::Trigger)
+    {
+        Parameters.RemoveAllSwap([&Parameter](const FAudioParameter& Existing)
+        {
+            return Existing.ParamName == Parameter.ParamName;
+        });
+    }
+
+    Parameters.Add(MoveTemp(Parameter));
+}
+
+void FDemuteAudioParameterBatch::Flush(UWorld* World)
+{
+    if (PendingParameters.Num() == 0)
+    {
+        return;
+    }
+
+    FAudioDevice* AudioDevice = World ? World->GetAudioDeviceRaw() : nullptr;
+
+    TArray<TPair<uint64, TArray<FAudioParameter>>> PlayingVoiceParameters;
+    PlayingVoiceParameters.Reserve(PendingParameters.Num());
+
+    for (TPair<TWeakObjectPtr<UAudioComponent>, TArray<FAudioParameter>>& Pending : PendingParameters)
+    {
+        UAudioComponent* AudioComponent = Pending.Key.Get();
+        if (!AudioComponent)
+        {
+            continue;
+        }
+
+        // Not playing yet: stored on the component and sent with the play command
+        if (!AudioDevice || !AudioComponent->IsPlaying())
+        {
+            AudioComponent->SetParameters(MoveTemp(Pending.Value));
+            continue;
+        }
+
+        PlayingVoiceParameters.Emplace(AudioComponent->GetAudioComponentID(), MoveTemp(Pending.Value));
+    }
+
+    PendingParameters.Reset();
+
+    if (PlayingVoiceParameters.Num() == 0)
+    {
+        return;
+    }
+
+    // One command for every playing voice, instead of one per parameter
+    FAudioThread::RunCommandOnAudioThread([AudioDevice, VoiceParameters = MoveTemp(PlayingVoiceParameters)]() mutable
+    {
+        for (TPair<uint64, TArray<FAudioParameter>>& Voice : VoiceParameters)
+        {
+            FActiveSound* ActiveSound = AudioDevice->FindActiveSound(Voice.Key);
+            if (!ActiveSound)
+            {
+                continue;
+            }
+
+            if (Audio::IParameterTransmitter* Transmitter = ActiveSound->GetTransmitter())
+            {
+                Transmitter->SetParameters(MoveTemp(Voice.Value));
+            }
+        }
+    });
+}
+
+void FDemuteAudioParameterBatch::Reset()
+{
+    PendingParameters.Reset();
+}
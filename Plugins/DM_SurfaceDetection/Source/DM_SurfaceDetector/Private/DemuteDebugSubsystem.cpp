@@ -1,30 +1,108 @@
 #include "DemuteDebugSubsystem.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Engine/GameInstance.h"
 #include "GameFramework/Actor.h"
 
+std::atomic<int32> UDemuteDebugSubsystem::NumSubsystemsWithDebugEnabled(0);
+
 void UDemuteDebugSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
     bFootstepLoggingEnabled = false;
     bPrintMaterialEnabled = false;
     ActorDebugSettings.Empty();
+    ResolvedActorDebugSettings.Empty();
+    PendingActorNames.Empty();
+    UpdateDebugEnabled();
 }
 
 void UDemuteDebugSubsystem::Deinitialize()
 {
+    bFootstepLoggingEnabled = false;
+    bPrintMaterialEnabled = false;
     ActorDebugSettings.Empty();
+    ResolvedActorDebugSettings.Empty();
+    PendingActorNames.Empty();
+    UpdateDebugEnabled();
     Super::Deinitialize();
 }
 
+void UDemuteDebugSubsystem::UpdateDebugEnabled()
+{
+    const bool bShouldBeEnabled = bFootstepLoggingEnabled || bPrintMaterialEnabled || ActorDebugSettings.Num() > 0;
+    if (bShouldBeEnabled != bDebugEnabled)
+    {
+        bDebugEnabled = bShouldBeEnabled;
+        NumSubsystemsWithDebugEnabled.fetch_add(bDebugEnabled ? 1 : -1, std::memory_order_relaxed);
+    }
+
+    // Only listen to spawns while some registered name is still unresolved
+    UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+    if (PendingActorNames.Num() > 0 && !ActorSpawnedHandle.IsValid() && World)
+    {
+        ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UDemuteDebugSubsystem::OnActorSpawned));
+    }
+    else if (PendingActorNames.Num() == 0 && ActorSpawnedHandle.IsValid())
+    {
+        if (World)
+        {
+            World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        }
+        ActorSpawnedHandle.Reset();
+    }
+}
+
+void UDemuteDebugSubsystem::ResolveActorName(const FString& ActorName)
+{
+    UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+    if (World)
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            if (It->GetName() == ActorName)
+            {
+                ResolvedActorDebugSettings.Add(FObjectKey(*It), ActorDebugSettings[ActorName]);
+                PendingActorNames.Remove(ActorName);
+                return;
+            }
+        }
+    }
+
+    PendingActorNames.Add(ActorName);
+    UE_LOG(LogTemp, Warning, TEXT("Actor '%s' not found yet, it will be debugged when it spawns"), *ActorName);
+}
+
+void UDemuteDebugSubsystem::OnActorSpawned(AActor* Actor)
+{
+    if (!Actor)
+    {
+        return;
+    }
+
+    const FString ActorName = Actor->GetName();
+    if (PendingActorNames.Remove(ActorName) > 0)
+    {
+        if (const FActorDebugSettings* Settings = ActorDebugSettings.Find(ActorName))
+        {
+            ResolvedActorDebugSettings.Add(FObjectKey(Actor), *Settings);
+        }
+        UpdateDebugEnabled();
+    }
+}
+
 void UDemuteDebugSubsystem::SetFootstepLogging(bool toggle)
 {
     bFootstepLoggingEnabled = toggle;
+    UpdateDebugEnabled();
     UE_LOG(LogTemp, Warning, TEXT("Global footstep logging %s"), bFootstepLoggingEnabled ? TEXT("Enabled") : TEXT("Disabled"));
 }
 
 void UDemuteDebugSubsystem::SetPrintMaterial(bool toggle)
 {
     bPrintMaterialEnabled = toggle;
+    UpdateDebugEnabled();
     UE_LOG(LogTemp, Warning, TEXT("Global footstep material printing %s"), bPrintMaterialEnabled ? TEXT("Enabled") : TEXT("Disabled"));
 }
 
@@ -61,6 +139,8 @@ void UDemuteDebugSubsystem::SetDebugMode(int32 mode)
         break;
     }
 
+    UpdateDebugEnabled();
+
     if (ActorDebugSettings.Num() > 0)
     {
         UE_LOG(LogTemp, Warning, TEXT("Solo mode active for %d actor(s)"), ActorDebugSettings.Num());
@@ -78,6 +158,10 @@ void UDemuteDebugSubsystem::AddActorDebugSettings(const FString& ActorName, bool
     FActorDebugSettings Settings(bEnablePrint, bEnableLogging);
     ActorDebugSettings.Add(ActorName, Settings);
 
+    // Resolve the name once here, footsteps only compare object keys
+    ResolveActorName(ActorName);
+    UpdateDebugEnabled();
+
     UE_LOG(LogTemp, Warning, TEXT("Added '%s' - Print: %s, Logging: %s (Total actors: %d)"),
         *ActorName,
         bEnablePrint ? TEXT("ON") : TEXT("OFF"),
@@ -85,10 +169,42 @@ void UDemuteDebugSubsystem::AddActorDebugSettings(const FString& ActorName, bool
         ActorDebugSettings.Num());
 }
 
+void UDemuteDebugSubsystem::AddActorDebugSettingsForActor(AActor* Actor, bool bEnablePrint, bool bEnableLogging)
+{
+    if (!Actor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot add null actor"));
+        return;
+    }
+
+    FActorDebugSettings Settings(bEnablePrint, bEnableLogging);
+    ActorDebugSettings.Add(Actor->GetName(), Settings);
+    ResolvedActorDebugSettings.Add(FObjectKey(Actor), Settings);
+    UpdateDebugEnabled();
+
+    UE_LOG(LogTemp, Warning, TEXT("Added '%s' - Print: %s, Logging: %s (Total actors: %d)"),
+        *Actor->GetName(),
+        bEnablePrint ? TEXT("ON") : TEXT("OFF"),
+        bEnableLogging ? TEXT("ON") : TEXT("OFF"),
+        ActorDebugSettings.Num());
+}
+
 void UDemuteDebugSubsystem::RemoveActorDebugSettings(const FString& ActorName)
 {
     if (ActorDebugSettings.Remove(ActorName) > 0)
     {
+        // Name lookups are fine here, this is a debug command and not the footstep path
+        for (auto It = ResolvedActorDebugSettings.CreateIterator(); It; ++It)
+        {
+            const UObject* Actor = It.Key().ResolveObjectPtr();
+            if (!Actor || Actor->GetName() == ActorName)
+            {
+                It.RemoveCurrent();
+            }
+        }
+        PendingActorNames.Remove(ActorName);
+        UpdateDebugEnabled();
+
         UE_LOG(LogTemp, Warning, TEXT("Removed '%s' from per-actor settings (Remaining: %d)"), *ActorName, ActorDebugSettings.Num());
     }
     else
@@ -101,45 +217,58 @@ void UDemuteDebugSubsystem::ClearActorDebugSettings()
 {
     int32 PreviousCount = ActorDebugSettings.Num();
     ActorDebugSettings.Empty();
+    ResolvedActorDebugSettings.Empty();
+    PendingActorNames.Empty();
+    UpdateDebugEnabled();
     UE_LOG(LogTemp, Warning, TEXT("Per-actor settings cleared (removed %d actor(s))"), PreviousCount);
 }
 
 bool UDemuteDebugSubsystem::ShouldShowPrintForActor(const AActor* Actor) const
 {
-    if (!Actor)
+#if DEMUTE_DEBUG_ENABLED
+    if (!bDebugEnabled || !Actor)
     {
         return false;
     }
 
-    FString ActorName = Actor->GetName();
-
     // Check if this actor has solo mode settings
-    if (const FActorDebugSettings* Settings = ActorDebugSettings.Find(ActorName))
+    if (ResolvedActorDebugSettings.Num() > 0)
     {
-        return Settings->bEnablePrint;
+        if (const FActorDebugSettings* Settings = ResolvedActorDebugSettings.Find(FObjectKey(Actor)))
+        {
+            return Settings->bEnablePrint;
+        }
     }
 
     // If no solo mode for this actor, use global setting
     return bPrintMaterialEnabled;
+#else
+    return false;
+#endif
 }
 
 bool UDemuteDebugSubsystem::ShouldShowLoggingForActor(const AActor* Actor) const
 {
-    if (!Actor)
+#if DEMUTE_DEBUG_ENABLED
+    if (!bDebugEnabled || !Actor)
     {
         return false;
     }
 
-    FString ActorName = Actor->GetName();
-
     // Check if this actor has solo mode settings
-    if (const FActorDebugSettings* Settings = ActorDebugSettings.Find(ActorName))
+    if (ResolvedActorDebugSettings.Num() > 0)
     {
-        return Settings->bEnableLogging;
+        if (const FActorDebugSettings* Settings = ResolvedActorDebugSettings.Find(FObjectKey(Actor)))
+        {
+            return Settings->bEnableLogging;
+        }
     }
 
     // If no solo mode for this actor, use global setting
     return bFootstepLoggingEnabled;
+#else
+    return false;
+#endif
 }
 
 void UDemuteDebugSubsystem::ShouldShow(const AActor* Actor, bool& bOutShouldPrint, bool& bOutShouldLog) const
@@ -148,15 +277,15 @@ void UDemuteDebugSubsystem::ShouldShow(const AActor* Actor, bool& bOutShouldPrin
     bOutShouldPrint = false;
     bOutShouldLog = false;
 
-    if (!Actor)
+#if DEMUTE_DEBUG_ENABLED
+    if (!bDebugEnabled || !Actor)
     {
         return;
     }
 
-    FString ActorName = Actor->GetName();
-
     // Check if actor has solo mode settings, otherwise use global
-    if (const FActorDebugSettings* Settings = ActorDebugSettings.Find(ActorName))
+    const FActorDebugSettings* Settings = ResolvedActorDebugSettings.Num() > 0 ? ResolvedActorDebugSettings.Find(FObjectKey(Actor)) : nullptr;
+    if (Settings)
     {
         bOutShouldPrint = Settings->bEnablePrint;
         bOutShouldLog = Settings->bEnableLogging;
@@ -166,57 +295,32 @@ void UDemuteDebugSubsystem::ShouldShow(const AActor* Actor, bool& bOutShouldPrin
         bOutShouldPrint = bPrintMaterialEnabled;
         bOutShouldLog = bFootstepLoggingEnabled;
     }
+#endif
 }
 
-// Helper function to format actor name from BP_ClassName0 to BP_ClassName_C_0
-static FString FormatActorName(const FString& InputName)
-{
-    // Check if the name ends with a digit
-    if (InputName.IsEmpty() || !FChar::IsDigit(InputName[InputName.Len() - 1]))
-    {
-        return InputName; // Return as-is if doesn't end with digit
-    }
-
-    // Find where the trailing digits start
-    int32 DigitStartIndex = InputName.Len() - 1;
-    while (DigitStartIndex > 0 && FChar::IsDigit(InputName[DigitStartIndex - 1]))
-    {
-        DigitStartIndex--;
-    }
-
-    // Check if "_C_" is already present before the digits
-    if (DigitStartIndex >= 3)
-    {
-        FString BeforeDigits = InputName.Left(DigitStartIndex);
-        if (BeforeDigits.EndsWith(TEXT("_C_")))
-        {
-            return InputName; // Already formatted correctly
-        }
-    }
-
-    // Split the name into prefix and number
-    FString Prefix = InputName.Left(DigitStartIndex);
-    FString Number = InputName.RightChop(DigitStartIndex);
-
-    // Insert "_C" before the underscore and number
-    return FString::Printf(TEXT("%s_C_%s"), *Prefix, *Number);
-}
+#if DEMUTE_DEBUG_ENABLED
 
 // Console command for footstep debug modes
 static FAutoConsoleCommandWithWorldAndArgs FootstepDebugCommand(
     TEXT("DEMUTE.Debug.PrintFootstepMaterial"),
-    TEXT("Control footstep debug. Usage:\n  DEMUTE.Debug.PrintFootstepMaterial <0|1|2|3> - Set global mode\n  DEMUTE.Debug.PrintFootstepMaterial <0|1|2|3> <ActorName> -solo - Solo mode for specific actor\nNote: Actor names like BP_ThirdPersonCharacter0 will be auto-formatted to BP_ThirdPersonCharacter_C_0\nExamples:\n  DEMUTE.Debug.PrintFootstepMaterial 1  (enable global printing)\n  DEMUTE.Debug.PrintFootstepMaterial 3 BP_ThirdPersonCharacter0 -solo  (solo mode)"),
+    TEXT("Control footstep debug. Usage:\n  DEMUTE.Debug.PrintFootstepMaterial <0|1|2|3> - Set global mode\nTo inspect a single actor, use the DemuteFootsteps Gameplay Debugger category\nExamples:\n  DEMUTE.Debug.PrintFootstepMaterial 1  (enable global printing)"),
     FConsoleCommandWithWorldAndArgsDelegate::CreateLambda(
         [](const TArray<FString>& Args, UWorld* World)
         {
             if (Args.Num() < 1)
             {
                 UE_LOG(LogTemp, Warning,
-                    TEXT("Usage:\n  DEMUTE.Debug.PrintFootstepMaterial <0|1|2|3> - Set global mode\n  DEMUTE.Debug.PrintFootstepMaterial <0|1|2|3> <ActorName> -solo - Solo mode for specific actor\n\nGlobal modes:\n  0 = All disabled\n  1 = Global printing only\n  2 = Global logging only\n  3 = Global printing + logging\n\nSolo mode:\n  Disables global debugging and enables only for specific actor\n  Mode number determines what to enable for the actor (1=print, 2=log, 3=both)\n  Actor names like BP_ThirdPersonCharacter0 will be auto-formatted to BP_ThirdPersonCharacter_C_0\n\nExamples:\n  DEMUTE.Debug.PrintFootstepMaterial 2\n  DEMUTE.Debug.PrintFootstepMaterial 3 BP_ThirdPersonCharacter0 -solo\n  DEMUTE.Debug.PrintFootstepMaterial 1 BP_Enemy0 -solo")
+                    TEXT("Usage:\n  DEMUTE.Debug.PrintFootstepMaterial <0|1|2|3> - Set global mode\n\nGlobal modes:\n  0 = All disabled\n  1 = Global printing only\n  2 = Global logging only\n  3 = Global printing + logging\n\nTo inspect a single actor, open the Gameplay Debugger (apostrophe key), select the actor and enable the DemuteFootsteps category.\n\nExamples:\n  DEMUTE.Debug.PrintFootstepMaterial 2")
                 );
                 return;
             }
 
+            if (Args.Num() >= 2)
+            {
+                // Solo mode matched actor names as strings; the Gameplay Debugger category selects the actor directly
+                UE_LOG(LogTemp, Warning, TEXT("Solo mode was replaced by the DemuteFootsteps Gameplay Debugger category: open the Gameplay Debugger (apostrophe key) and select the actor. Only the global mode is applied."));
+            }
+
             if (!World)
             {
                 UE_LOG(LogTemp, Warning, TEXT("World is null"));
@@ -244,44 +348,8 @@ static FAutoConsoleCommandWithWorldAndArgs FootstepDebugCommand(
             {
                 int32 mode = FCString::Atoi(*FirstArg);
 
-                // Check if there's a -solo argument
-                bool bSoloMode = false;
-                FString ActorName;
-
-                if (Args.Num() >= 2)
-                {
-                    ActorName = Args[1];
-
-                    // Check for -solo flag
-                    if (Args.Num() >= 3 && Args[2].ToLower() == TEXT("-solo"))
-                    {
-                        bSoloMode = true;
-                    }
-                }
-
-                if (bSoloMode && !ActorName.IsEmpty())
-                {
-                    // Format the actor name (BP_ClassName0 -> BP_ClassName_C_0)
-                    FString FormattedActorName = FormatActorName(ActorName);
-
-                    // Solo mode: disable global, enable for specific actor based on mode
-                    DebugSubsystem->SetDebugMode(0); // Disable global
-
-                    bool bEnablePrint = (mode == 1 || mode == 3);
-                    bool bEnableLog = (mode == 2 || mode == 3);
-
-                    DebugSubsystem->AddActorDebugSettings(FormattedActorName, bEnablePrint, bEnableLog);
-
-                    UE_LOG(LogTemp, Warning, TEXT("Solo mode: Global disabled, actor '%s' set to mode %d (Print: %s, Log: %s)"),
-                        *FormattedActorName, mode,
-                        bEnablePrint ? TEXT("ON") : TEXT("OFF"),
-                        bEnableLog ? TEXT("ON") : TEXT("OFF"));
-                }
-                else
-                {
-                    // Set global debug mode
-                    DebugSubsystem->SetDebugMode(mode);
-                }
+                // Set global debug mode
+                DebugSubsystem->SetDebugMode(mode);
             }
             else
             {
@@ -294,7 +362,7 @@ static FAutoConsoleCommandWithWorldAndArgs FootstepDebugCommand(
 // Console command to clear everything
 static FAutoConsoleCommandWithWorldAndArgs ClearFootstepDebuggingCommand(
     TEXT("DEMUTE.Debug.ClearFootstepDebugging"),
-    TEXT("Clear all footstep debugging settings (global and solo actors)"),
+    TEXT("Clear all footstep debugging settings (global and per-actor)"),
     FConsoleCommandWithWorldAndArgsDelegate::CreateLambda(
         [](const TArray<FString>& Args, UWorld* World)
         {
@@ -321,10 +389,12 @@ static FAutoConsoleCommandWithWorldAndArgs ClearFootstepDebuggingCommand(
             // Clear global settings
             DebugSubsystem->SetDebugMode(0);
 
-            // Clear solo actor settings
+            // Clear per-actor settings
             DebugSubsystem->ClearActorDebugSettings();
 
-            UE_LOG(LogTemp, Warning, TEXT("All footstep debugging cleared (global + solo actors)"));
+            UE_LOG(LogTemp, Warning, TEXT("All footstep debugging cleared (global + per-actor)"));
         }
     )
-);
\ No newline at end of file
+);
+
+#endif // DEMUTE_DEBUG_ENABLED
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// CSV profiler category of the footstep pipeline, defined in DemuteSurfaceSubsystem.cpp.
+// Capture with -csvCategories=DemuteFootsteps (enabled by default).
+CSV_DECLARE_CATEGORY_EXTERN(DemuteFootsteps);
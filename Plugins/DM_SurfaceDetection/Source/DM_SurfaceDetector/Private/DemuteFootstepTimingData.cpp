@@ -0,0 +1,86 @@
+#include "DemuteFootstepTimingData.h"
+#include "Algo/BinarySearch.h"
+#include "Animation/AnimationAsset.h"
+
+UDemuteFootstepTimingData* UDemuteFootstepTimingData::Find(UAnimationAsset* Animation)
+{
+    return Animation ? Animation->GetAssetUserData<UDemuteFootstepTimingData>() : nullptr;
+}
+
+bool UDemuteFootstepTimingData::GetNextContact(float Time, bool bLooping, FDemuteFootstepContact& OutContact, float& OutTimeToContact) const
+{
+    if (PlayLength <= 0.0f || Contacts.Num() == 0)
+    {
+        return false;
+    }
+
+    if (bLooping)
+    {
+        Time = FMath::Fmod(Time, PlayLength);
+        if (Time < 0.0f)
+        {
+            Time += PlayLength;
+        }
+    }
+
+    const float Phase = Time / PlayLength;
+
+    // Contacts are sorted by phase
+    const int32 NextIndex = Algo::UpperBoundBy(Contacts, Phase, &FDemuteFootstepContact::Phase);
+    if (Contacts.IsValidIndex(NextIndex))
+    {
+        OutContact = Contacts[NextIndex];
+        OutTimeToContact = (OutContact.Phase - Phase) * PlayLength;
+        return true;
+    }
+
+    if (!bLooping)
+    {
+        return false;
+    }
+
+    OutContact = Contacts[0];
+    OutTimeToContact = (1.0f - Phase + OutContact.Phase) * PlayLength;
+    return true;
+}
+
+void UDemuteFootstepTimingData::GetContactsBetween(float StartTime, float EndTime, bool bLooping, TArray<FDemuteFootstepContact>& OutContacts) const
+{
+    OutContacts.Reset();
+
+    if (PlayLength <= 0.0f)
+    {
+        return;
+    }
+
+    if (!bLooping)
+    {
+        for (const FDemuteFootstepContact& Contact : Contacts)
+        {
+            const float ContactTime = Contact.Phase * PlayLength;
+            if (ContactTime > StartTime && ContactTime <= EndTime)
+            {
+                OutContacts.Add(Contact);
+            }
+        }
+        return;
+    }
+
+    // Wrapped around the loop point since StartTime
+    if (EndTime < StartTime)
+    {
+        EndTime += PlayLength;
+    }
+
+    for (int32 Loop = FMath::FloorToInt(StartTime / PlayLength); Loop * PlayLength <= EndTime; ++Loop)
+    {
+        for (const FDemuteFootstepContact& Contact : Contacts)
+        {
+            const float ContactTime = (Loop + Contact.Phase) * PlayLength;
+            if (ContactTime > StartTime && ContactTime <= EndTime)
+            {
+                OutContacts.Add(Contact);
+            }
+        }
+    }
+}
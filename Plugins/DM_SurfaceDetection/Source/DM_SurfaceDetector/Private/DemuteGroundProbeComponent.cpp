@@ -0,0 +1,60 @@
+#include "DemuteGroundProbeComponent.h"
+#include "DemuteFootstepCsvStats.h"
+#include "CollisionQueryParams.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+
+const FDemuteGroundHit& UDemuteGroundProbeComponent::GetGround()
+{
+    if (ProbeFrame != GFrameCounter)
+    {
+        ProbeFrame = GFrameCounter;
+        Probe();
+    }
+
+    return Ground;
+}
+
+void UDemuteGroundProbeComponent::Invalidate()
+{
+    ProbeFrame = TNumericLimits<uint64>::Max();
+}
+
+bool UDemuteGroundProbeComponent::MatchesTrace(ETraceTypeQuery TraceChannel, bool bComplex) const
+{
+    return UEngineTypes::ConvertToCollisionChannel(TraceChannel) == ProbeChannel && bComplex == bTraceComplex;
+}
+
+void UDemuteGroundProbeComponent::Probe()
+{
+    Ground = FDemuteGroundHit();
+
+    AActor* Owner = GetOwner();
+    UWorld* World = GetWorld();
+    if (!Owner || !World)
+    {
+        return;
+    }
+
+    CSV_CUSTOM_STAT(DemuteFootsteps, Traces, 1, ECsvCustomStatOp::Accumulate);
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(DemuteGroundProbe), bTraceComplex, Owner);
+    QueryParams.bReturnPhysicalMaterial = true;
+
+    const FVector Start = Owner->GetActorLocation();
+    const FVector End = Start - FVector(0.0f, 0.0f, ProbeDistance);
+
+    if (!World->LineTraceSingleByChannel(Ground.Hit, Start, End, ProbeChannel, QueryParams))
+    {
+        return;
+    }
+
+    Ground.bHit = true;
+    Ground.Distance = Ground.Hit.Distance;
+    Ground.Location = Ground.Hit.ImpactPoint;
+    Ground.Normal = Ground.Hit.ImpactNormal;
+    Ground.Component = Ground.Hit.GetComponent();
+    Ground.SurfaceType = Ground.Hit.PhysMaterial.IsValid() ? Ground.Hit.PhysMaterial->SurfaceType : SurfaceType_Default;
+}
@@ -0,0 +1,204 @@
+#include "DemuteProceduralFootstepComponent.h"
+#include "DemuteFootstepCsvStats.h"
+#include "DemuteSurfaceSubsystem.h"
+#include "DemuteSurfaceSettings.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+
+float FDemuteStrideProfile::GetStepLength(float Speed) const
+{
+    const float StepLength = FMath::GetMappedRangeValueClamped(
+        FVector2f(WalkSpeed, FMath::Max(RunSpeed, WalkSpeed + 1.0f)),
+        FVector2f(WalkStepLength, RunStepLength),
+        Speed);
+
+    // Past the highest cadence, longer steps instead of faster ones
+    return FMath::Max3(StepLength, Speed / FMath::Max(MaxCadence, 0.1f), 1.0f);
+}
+
+UDemuteProceduralFootstepComponent::UDemuteProceduralFootstepComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+void UDemuteProceduralFootstepComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (const AActor* Owner = GetOwner())
+    {
+        Mesh = Owner->FindComponentByClass<USkeletalMeshComponent>();
+    }
+}
+
+bool UDemuteProceduralFootstepComponent::NotifyAnimFootstep(FName Foot)
+{
+    const UWorld* World = GetWorld();
+    LastNotifyTime = World ? World->GetTimeSeconds() : 0.0;
+
+    // Late notifies of a throttled animation would double the procedural footsteps
+    if (IsGeneratingFootsteps())
+    {
+        return false;
+    }
+
+    StepDistance = 0.0f;
+
+    if (Foot == LeftFootName)
+    {
+        bLeftFootNext = false;
+    }
+    else if (Foot == RightFootName)
+    {
+        bLeftFootNext = true;
+    }
+
+    return true;
+}
+
+bool UDemuteProceduralFootstepComponent::IsGeneratingFootsteps() const
+{
+    return Mode == EDemuteProceduralFootstepMode::Always || AreNotifiesSkipped();
+}
+
+bool UDemuteProceduralFootstepComponent::AreNotifiesSkipped() const
+{
+    if (!Mesh || !Mesh->IsComponentTickEnabled() || Mesh->bPauseAnims)
+    {
+        return true;
+    }
+
+    // Offscreen meshes stop ticking their pose, and their notifies, with every option but the two "Always" ones
+    const EVisibilityBasedAnimTickOption TickOption = Mesh->VisibilityBasedAnimTickOption;
+    const bool bTicksWhenNotRendered = TickOption == EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones
+        || TickOption == EVisibilityBasedAnimTickOption::AlwaysTickPose;
+    if (!bTicksWhenNotRendered && !Mesh->bRecentlyRendered)
+    {
+        return true;
+    }
+
+    // URO still fires the notifies, but only on evaluated frames: too late at low update rates
+    if (Mesh->ShouldUseUpdateRateOptimizations() && Mesh->AnimUpdateRateParams
+        && Mesh->AnimUpdateRateParams->UpdateRate > MaxNotifyUpdateRate)
+    {
+        return true;
+    }
+
+    // Moving for a while without any notify: the animation is throttled some other way
+    if (NotifyTimeout > 0.0f && LastNotifyTime >= 0.0 && bMoving)
+    {
+        const UWorld* World = GetWorld();
+        const double SilentSince = FMath::Max(LastNotifyTime, MoveStartTime);
+        if (World && World->GetTimeSeconds() - SilentSince > NotifyTimeout)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void UDemuteProceduralFootstepComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Total);
+
+    const AActor* Owner = GetOwner();
+    const UWorld* World = GetWorld();
+    if (!Owner || !World)
+    {
+        return;
+    }
+
+    // Airborne characters don't step. Actors without pawn movement are assumed on the ground.
+    bool bOnGround = true;
+    if (const APawn* Pawn = Cast<APawn>(Owner))
+    {
+        if (const UPawnMovementComponent* Movement = Pawn->GetMovementComponent())
+        {
+            bOnGround = Movement->IsMovingOnGround();
+        }
+    }
+
+    const float Speed = Owner->GetVelocity().Size2D();
+    const bool bWasMoving = bMoving;
+    bMoving = bOnGround && Speed >= StrideProfile.MinSpeed;
+
+    if (!bMoving)
+    {
+        // First step after stopping comes half a step after starting again
+        StepDistance = 0.5f * StrideProfile.GetStepLength(StrideProfile.WalkSpeed);
+        return;
+    }
+
+    if (!bWasMoving)
+    {
+        MoveStartTime = World->GetTimeSeconds();
+    }
+
+    // The cadence runs even while notifies fire, so procedural steps take over in phase
+    StepDistance += Speed * DeltaTime;
+    const float StepLength = StrideProfile.GetStepLength(Speed);
+    if (StepDistance < StepLength)
+    {
+        return;
+    }
+
+    // A single footstep after a hitch, the remainder keeps the phase
+    StepDistance = FMath::Fmod(StepDistance, StepLength);
+
+    if (!IsGeneratingFootsteps())
+    {
+        return;
+    }
+
+    // The foot landed when the step length was reached, earlier in the frame
+    RequestStep(Speed, World->GetTimeSeconds() - StepDistance / Speed);
+}
+
+void UDemuteProceduralFootstepComponent::RequestStep(float Speed, double ContactTime)
+{
+    AActor* Owner = GetOwner();
+    UWorld* World = GetWorld();
+    UDemuteSurfaceSubsystem* SurfaceSubsystem = World ? World->GetSubsystem<UDemuteSurfaceSubsystem>() : nullptr;
+    if (!Metasound || !SurfaceSubsystem)
+    {
+        return;
+    }
+
+    const bool bLeftFoot = bLeftFootNext;
+    bLeftFootNext = !bLeftFootNext;
+
+    float CollisionRadius = 0.0f;
+    float CollisionHalfHeight = 0.0f;
+    Owner->GetSimpleCollisionCylinder(CollisionRadius, CollisionHalfHeight);
+
+    // The pose may be stale, so feet are placed from the actor: half the spacing to each side
+    const FVector Start = Owner->GetActorLocation() + Owner->GetActorRightVector() * (bLeftFoot ? -0.5f : 0.5f) * FootSpacing;
+
+    const FDemuteSurfacePerformancePolicy& Policy = UDemuteSurfaceSettings::Get()->GetPolicy();
+
+    FDemuteFootstepRequest Request;
+    Request.Instigator = Owner;
+    Request.Foot = bLeftFoot ? LeftFootName : RightFootName;
+    Request.Start = Start;
+    Request.End = Start - FVector(0.0f, 0.0f, CollisionHalfHeight + (bUseProjectTraceSettings ? Policy.TraceLength : TraceLength));
+    Request.TraceChannel = bUseProjectTraceSettings ? Policy.TraceChannel : TraceChannel;
+    Request.bTraceComplex = bUseProjectTraceSettings ? Policy.bTraceComplex : bTraceComplex;
+    Request.SurfaceData = AudioSurfaceData;
+    Request.Sound = Metasound;
+    Request.SurfaceParameterName = SurfaceParameterName;
+    Request.Intensity = FMath::Clamp(Speed / FMath::Max(StrideProfile.RunSpeed, 1.0f), 0.0f, 1.0f);
+    Request.IntensityParameterName = IntensityParameterName;
+    Request.Significance = Significance;
+    Request.bAllowCrowdAggregation = bAllowCrowdAggregation;
+    Request.CrowdSound = CrowdSound;
+    Request.ContactTime = ContactTime;
+
+    CSV_CUSTOM_STAT(DemuteFootsteps, ProceduralFootsteps, 1, ECsvCustomStatOp::Accumulate);
+    SurfaceSubsystem->RequestFootstep(Request);
+}
@@ -0,0 +1,283 @@
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundFacade.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundTrigger.h"
+#include "Math/RandomStream.h"
+
+#define LOCTEXT_NAMESPACE "DemuteRandomVariationNode"
+
+/**
+ * Native replacement for the DEM_RandomOneShot_Mono_MSS and DEM_GetPitchShift_MSP patches.
+ *
+ * On each trigger the node draws the next variation index from a shuffle bag (every variation
+ * plays once before any repeats, and the same index never plays twice in a row), and rolls a
+ * pitch shift and volume for that voice. All of it runs in one operator, and the state lives in
+ * the operator itself, so it is naturally kept per source instance.
+ *
+ * Bag Index lets a single node keep one bag per surface: switching surfaces does not lose the
+ * no-repeat history of the previous one. Feed it the surface index, or leave it at 0.
+ */
+namespace Metasound
+{
+    namespace DemuteRandomVariationVertexNames
+    {
+        METASOUND_PARAM(InputTrigger, "Trigger", "Draws a new variation and new pitch/volume values.");
+        METASOUND_PARAM(InputNumVariations, "Num Variations", "Number of variations to draw from.");
+        METASOUND_PARAM(InputBagIndex, "Bag Index", "Which shuffle bag to draw from (e.g. the surface index). Each bag keeps its own no-repeat history.");
+        METASOUND_PARAM(InputPitchVariation, "Pitch Variation", "Random pitch shift range in semitones (+/-).");
+        METASOUND_PARAM(InputVolumeVariation, "Volume Variation", "Random attenuation range in decibels (0 to -value).");
+        METASOUND_PARAM(InputSeed, "Seed", "Seed of the random generator. -1 uses a random seed.");
+
+        METASOUND_PARAM(OutputOnTrigger, "On Trigger", "Triggered once the new values are available.");
+        METASOUND_PARAM(OutputIndex, "Index", "The selected variation index (-1 if Num Variations is 0).");
+        METASOUND_PARAM(OutputPitchShift, "Pitch Shift", "Pitch shift in semitones, to plug in the Wave Player.");
+        METASOUND_PARAM(OutputVolume, "Volume", "Linear volume multiplier.");
+    }
+
+    class FDemuteRandomVariationOperator : public TExecutableOperator<FDemuteRandomVariationOperator>
+    {
+    public:
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto InitNodeInfo = []() -> FNodeClassMetadata
+            {
+                FNodeClassMetadata Info;
+                Info.ClassName = { TEXT("Demute"), TEXT("Random Variation"), TEXT("") };
+                Info.MajorVersion = 1;
+                Info.MinorVersion = 0;
+                Info.DisplayName = LOCTEXT("Metasound_RandomVariationDisplayName", "Random Variation (No Repeat)");
+                Info.Description = LOCTEXT("Metasound_RandomVariationDescription", "Shuffle-bag variation selection with seeded pitch and volume jitter, in a single operator.");
+                Info.Author = LOCTEXT("Metasound_DemuteAuthor", "Demute Studio");
+                Info.PromptIfMissing = LOCTEXT("Metasound_DemuteMissingPrompt", "Make sure the DM Surface Detection plugin is enabled.");
+                Info.DefaultInterface = GetVertexInterface();
+                Info.CategoryHierarchy = { LOCTEXT("Metasound_DemuteCategory", "Demute") };
+                return Info;
+            };
+
+            static const FNodeClassMetadata Info = InitNodeInfo();
+            return Info;
+        }
+
+        static const FVertexInterface& GetVertexInterface()
+        {
+            using namespace DemuteRandomVariationVertexNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTrigger)),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputNumVariations), 1),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBagIndex), 0),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputPitchVariation), 0.5f),
+                    TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputVolumeVariation), 2.0f),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSeed), -1)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputOnTrigger)),
+                    TOutputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputIndex)),
+                    TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputPitchShift)),
+                    TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputVolume))
+                )
+            );
+
+            return Interface;
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace DemuteRandomVariationVertexNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            return MakeUnique<FDemuteRandomVariationOperator>(
+                InParams.OperatorSettings,
+                InputData.GetOrCreateDefaultDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputNumVariations), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputBagIndex), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputPitchVariation), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputVolumeVariation), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputSeed), InParams.OperatorSettings)
+            );
+        }
+
+        FDemuteRandomVariationOperator(
+            const FOperatorSettings& InSettings,
+            const FTriggerReadRef& InTrigger,
+            const FInt32ReadRef& InNumVariations,
+            const FInt32ReadRef& InBagIndex,
+            const FFloatReadRef& InPitchVariation,
+            const FFloatReadRef& InVolumeVariation,
+            const FInt32ReadRef& InSeed)
+            : TriggerInput(InTrigger)
+            , NumVariationsInput(InNumVariations)
+            , BagIndexInput(InBagIndex)
+            , PitchVariationInput(InPitchVariation)
+            , VolumeVariationInput(InVolumeVariation)
+            , SeedInput(InSeed)
+            , OnTriggerOutput(FTriggerWriteRef::CreateNew(InSettings))
+            , IndexOutput(FInt32WriteRef::CreateNew(INDEX_NONE))
+            , PitchShiftOutput(FFloatWriteRef::CreateNew(0.0f))
+            , VolumeOutput(FFloatWriteRef::CreateNew(1.0f))
+        {
+            ResetRandomStream();
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace DemuteRandomVariationVertexNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), TriggerInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputNumVariations), NumVariationsInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBagIndex), BagIndexInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputPitchVariation), PitchVariationInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputVolumeVariation), VolumeVariationInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSeed), SeedInput);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace DemuteRandomVariationVertexNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputOnTrigger), OnTriggerOutput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputIndex), IndexOutput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputPitchShift), PitchShiftOutput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputVolume), VolumeOutput);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            OnTriggerOutput->Reset();
+            *IndexOutput = INDEX_NONE;
+            *PitchShiftOutput = 0.0f;
+            *VolumeOutput = 1.0f;
+            Bags.Reset();
+            ResetRandomStream();
+        }
+
+        void Execute()
+        {
+            OnTriggerOutput->AdvanceBlock();
+
+            if (*SeedInput != CurrentSeed)
+            {
+                Bags.Reset();
+                ResetRandomStream();
+            }
+
+            TriggerInput->ExecuteBlock(
+                [](int32, int32) {},
+                [this](int32 StartFrame, int32 EndFrame)
+                {
+                    *IndexOutput = DrawFromBag(*BagIndexInput, *NumVariationsInput);
+
+                    const float PitchVariation = FMath::Abs(*PitchVariationInput);
+                    *PitchShiftOutput = RandomStream.FRandRange(-PitchVariation, PitchVariation);
+
+                    const float VolumeVariation = FMath::Abs(*VolumeVariationInput);
+                    const float VolumeDecibels = -RandomStream.FRandRange(0.0f, VolumeVariation);
+                    *VolumeOutput = FMath::Pow(10.0f, VolumeDecibels / 20.0f);
+
+                    OnTriggerOutput->TriggerFrame(StartFrame);
+                }
+            );
+        }
+
+    private:
+        /** Shuffled list of variation indices, consumed front to back */
+        struct FShuffleBag
+        {
+            TArray<int32> Indices;
+            int32 NextIndex = 0;
+            int32 LastDrawn = INDEX_NONE;
+        };
+
+        int32 DrawFromBag(int32 BagIndex, int32 NumVariations)
+        {
+            if (NumVariations <= 0)
+            {
+                return INDEX_NONE;
+            }
+
+            FShuffleBag& Bag = Bags.FindOrAdd(BagIndex);
+
+            // Variation count changed (new wave set) - start over with a fresh bag
+            if (Bag.Indices.Num() != NumVariations)
+            {
+                Bag.Indices.SetNumUninitialized(NumVariations);
+                for (int32 i = 0; i < NumVariations; ++i)
+                {
+                    Bag.Indices[i] = i;
+                }
+                Bag.NextIndex = NumVariations;
+            }
+
+            if (Bag.NextIndex >= Bag.Indices.Num())
+            {
+                Shuffle(Bag);
+            }
+
+            Bag.LastDrawn = Bag.Indices[Bag.NextIndex++];
+            return Bag.LastDrawn;
+        }
+
+        void Shuffle(FShuffleBag& Bag)
+        {
+            const int32 Num = Bag.Indices.Num();
+            for (int32 i = Num - 1; i > 0; --i)
+            {
+                Bag.Indices.Swap(i, RandomStream.RandRange(0, i));
+            }
+
+            // Never repeat the last variation of the previous bag across the reshuffle
+            if (Num > 1 && Bag.Indices[0] == Bag.LastDrawn)
+            {
+                Bag.Indices.Swap(0, RandomStream.RandRange(1, Num - 1));
+            }
+
+            Bag.NextIndex = 0;
+        }
+
+        void ResetRandomStream()
+        {
+            CurrentSeed = *SeedInput;
+            if (CurrentSeed == -1)
+            {
+                RandomStream.GenerateNewSeed();
+            }
+            else
+            {
+                RandomStream.Initialize(CurrentSeed);
+            }
+        }
+
+        FTriggerReadRef TriggerInput;
+        FInt32ReadRef NumVariationsInput;
+        FInt32ReadRef BagIndexInput;
+        FFloatReadRef PitchVariationInput;
+        FFloatReadRef VolumeVariationInput;
+        FInt32ReadRef SeedInput;
+
+        FTriggerWriteRef OnTriggerOutput;
+        FInt32WriteRef IndexOutput;
+        FFloatWriteRef PitchShiftOutput;
+        FFloatWriteRef VolumeOutput;
+
+        TMap<int32, FShuffleBag> Bags;
+        FRandomStream RandomStream;
+        int32 CurrentSeed = -1;
+    };
+
+    class FDemuteRandomVariationNode : public FNodeFacade
+    {
+    public:
+        FDemuteRandomVariationNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FDemuteRandomVariationOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FDemuteRandomVariationNode)
+}
+
+#undef LOCTEXT_NAMESPACE
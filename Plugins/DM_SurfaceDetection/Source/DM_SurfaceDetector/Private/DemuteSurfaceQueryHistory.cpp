@@ -0,0 +1,121 @@
+#include "DemuteSurfaceQueryHistory.h"
+#include "Components/LineBatchComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#if DEMUTE_DEBUG_ENABLED
+static TAutoConsoleVariable<int32> CVarDrawSurfaceQueries(
+    TEXT("DEMUTE.Debug.DrawSurfaceQueries"),
+    0,
+    TEXT("Draw the recent footstep surface queries.\n  0 = off\n  1 = colour by surface type (red = miss, grey = no valid surface)\n  2 = colour by cost"),
+    ECVF_Cheat);
+
+static TAutoConsoleVariable<int32> CVarSurfaceQueryHistorySize(
+    TEXT("DEMUTE.Debug.SurfaceQueryHistorySize"),
+    256,
+    TEXT("Number of recent surface queries kept for DEMUTE.Debug.DrawSurfaceQueries"),
+    ECVF_Cheat);
+
+static TAutoConsoleVariable<float> CVarSurfaceQueryMaxCost(
+    TEXT("DEMUTE.Debug.SurfaceQueryMaxCost"),
+    50.0f,
+    TEXT("Cost in microseconds drawn fully red when DEMUTE.Debug.DrawSurfaceQueries is 2"),
+    ECVF_Cheat);
+#endif
+
+bool FDemuteSurfaceQueryHistory::IsRecording()
+{
+#if DEMUTE_DEBUG_ENABLED
+    return CVarDrawSurfaceQueries.GetValueOnGameThread() > 0;
+#else
+    return false;
+#endif
+}
+
+void FDemuteSurfaceQueryHistory::Add(const FDemuteSurfaceQueryRecord& Record)
+{
+#if DEMUTE_DEBUG_ENABLED
+    const int32 Capacity = FMath::Max(1, CVarSurfaceQueryHistorySize.GetValueOnGameThread());
+
+    // Capacity changed from the console: start over rather than reorder
+    if (Records.Num() > Capacity)
+    {
+        Reset();
+    }
+
+    if (Records.Num() < Capacity)
+    {
+        Records.Add(Record);
+        return;
+    }
+
+    Records[NextIndex] = Record;
+    NextIndex = (NextIndex + 1) % Capacity;
+#endif
+}
+
+void FDemuteSurfaceQueryHistory::Draw(UWorld* World) const
+{
+#if DEMUTE_DEBUG_ENABLED
+    const int32 DrawMode = CVarDrawSurfaceQueries.GetValueOnGameThread();
+    if (DrawMode <= 0 || Records.Num() == 0 || !World)
+    {
+        return;
+    }
+
+    ULineBatchComponent* LineBatcher = World->GetLineBatcher(UWorld::ELineBatcherType::World);
+    if (!LineBatcher)
+    {
+        return;
+    }
+
+    const float MaxCost = FMath::Max(CVarSurfaceQueryMaxCost.GetValueOnGameThread(), KINDA_SMALL_NUMBER);
+    constexpr float CrossSize = 5.0f;
+    constexpr float Thickness = 1.0f;
+
+    // One trace line plus a three-line cross at each hit
+    TArray<FBatchedLine> Lines;
+    Lines.Reserve(Records.Num() * 4);
+
+    for (const FDemuteSurfaceQueryRecord& Record : Records)
+    {
+        FLinearColor Color;
+        if (DrawMode == 2)
+        {
+            Color = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, FMath::Clamp(Record.CostMicroseconds / MaxCost, 0.0f, 1.0f));
+        }
+        else if (!Record.bHit)
+        {
+            Color = FLinearColor::Red;
+        }
+        else if (!Record.bFoundSurface)
+        {
+            Color = FLinearColor::Gray;
+        }
+        else
+        {
+            // Golden ratio hue steps keep neighbouring surface types apart
+            const float Hue = FMath::Fmod(Record.SurfaceType.GetValue() * 0.618034f, 1.0f) * 360.0f;
+            Color = FLinearColor(Hue, 0.8f, 1.0f).HSVToLinearRGB();
+        }
+
+        const FVector LineEnd = Record.bHit ? Record.HitLocation : Record.End;
+        Lines.Emplace(Record.Start, LineEnd, Color, -1.0f, Thickness, SDPG_World);
+
+        if (Record.bHit)
+        {
+            Lines.Emplace(LineEnd - FVector(CrossSize, 0, 0), LineEnd + FVector(CrossSize, 0, 0), Color, -1.0f, Thickness, SDPG_World);
+            Lines.Emplace(LineEnd - FVector(0, CrossSize, 0), LineEnd + FVector(0, CrossSize, 0), Color, -1.0f, Thickness, SDPG_World);
+            Lines.Emplace(LineEnd - FVector(0, 0, CrossSize), LineEnd + FVector(0, 0, CrossSize), Color, -1.0f, Thickness, SDPG_World);
+        }
+    }
+
+    LineBatcher->DrawLines(Lines);
+#endif
+}
+
+void FDemuteSurfaceQueryHistory::Reset()
+{
+    Records.Reset();
+    NextIndex = 0;
+}
@@ -0,0 +1,241 @@
+#include "DemuteSurfaceQueryRecorder.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+namespace DemuteSurfaceQueryRecording
+{
+    static constexpr uint32 Magic = 0x51534D44; // "DMSQ"
+    static constexpr uint32 Version = 1;
+
+    // Path index 0 is "no object", new paths get the next index and are followed by their string
+    static constexpr uint32 NullPathIndex = 0;
+
+    enum EFlags : uint8
+    {
+        TraceComplex = 1 << 0,
+        Hit = 1 << 1,
+        FoundSurface = 1 << 2,
+    };
+}
+
+bool FDemuteSurfaceQueryRecorder::bIsRecording = false;
+
+FDemuteSurfaceQueryRecorder& FDemuteSurfaceQueryRecorder::Get()
+{
+    static FDemuteSurfaceQueryRecorder Recorder;
+    return Recorder;
+}
+
+bool FDemuteSurfaceQueryRecorder::Start(const FString& Filename, const FString& MapName)
+{
+    Stop();
+
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot open surface query recording '%s'"), *Filename);
+        return false;
+    }
+
+    uint32 Magic = DemuteSurfaceQueryRecording::Magic;
+    uint32 Version = DemuteSurfaceQueryRecording::Version;
+    FString Map = MapName;
+    *Writer << Magic;
+    *Writer << Version;
+    *Writer << Map;
+
+    PathIndices.Reset();
+    NumRecorded = 0;
+    bIsRecording = true;
+
+    UE_LOG(LogTemp, Log, TEXT("Recording surface queries to '%s'"), *Filename);
+    return true;
+}
+
+void FDemuteSurfaceQueryRecorder::Stop()
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    Writer->Close();
+    Writer.Reset();
+    PathIndices.Reset();
+    bIsRecording = false;
+
+    UE_LOG(LogTemp, Log, TEXT("Surface query recording stopped (%d queries)"), NumRecorded);
+}
+
+void FDemuteSurfaceQueryRecorder::WritePath(const UObject* Object)
+{
+    uint32 Index = DemuteSurfaceQueryRecording::NullPathIndex;
+    if (Object)
+    {
+        if (const uint32* KnownIndex = PathIndices.Find(Object))
+        {
+            Index = *KnownIndex;
+        }
+        else
+        {
+            Index = PathIndices.Num() + 1;
+            PathIndices.Add(Object, Index);
+
+            Writer->SerializeIntPacked(Index);
+            FString Path = Object->GetPathName();
+            *Writer << Path;
+            return;
+        }
+    }
+
+    Writer->SerializeIntPacked(Index);
+}
+
+void FDemuteSurfaceQueryRecorder::Record(double Time, const FVector& Start, const FVector& End, ETraceTypeQuery TraceChannel, bool bTraceComplex,
+    const UObject* ActorClass, const UObject* SurfaceData, bool bHit, bool bFoundSurface, int32 MetasoundParameter,
+    TEnumAsByte<EPhysicalSurface> SurfaceType)
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    using namespace DemuteSurfaceQueryRecording;
+
+    FVector RecordStart = Start;
+    FVector RecordEnd = End;
+    uint8 Channel = static_cast<uint8>(TraceChannel);
+    uint8 Flags = (bTraceComplex ? TraceComplex : 0) | (bHit ? Hit : 0) | (bFoundSurface ? FoundSurface : 0);
+    uint8 Surface = SurfaceType.GetValue();
+
+    *Writer << Time;
+    *Writer << RecordStart;
+    *Writer << RecordEnd;
+    *Writer << Channel;
+    *Writer << Flags;
+    WritePath(ActorClass);
+    WritePath(SurfaceData);
+    *Writer << MetasoundParameter;
+    *Writer << Surface;
+
+    NumRecorded++;
+}
+
+bool FDemuteSurfaceQueryRecorder::LoadFile(const FString& Filename, FString& OutMapName, TArray<FDemuteRecordedSurfaceQuery>& OutQueries)
+{
+    using namespace DemuteSurfaceQueryRecording;
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+    if (!Reader)
+    {
+        return false;
+    }
+
+    uint32 FileMagic = 0;
+    uint32 FileVersion = 0;
+    *Reader << FileMagic;
+    *Reader << FileVersion;
+    if (FileMagic != Magic || FileVersion != Version)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("'%s' is not a surface query recording (or an unsupported version)"), *Filename);
+        return false;
+    }
+
+    *Reader << OutMapName;
+
+    TArray<FString> Paths;
+    Paths.Add(FString());
+
+    auto ReadPath = [&Reader, &Paths](FString& OutPath)
+    {
+        uint32 Index = 0;
+        Reader->SerializeIntPacked(Index);
+        if (Index == static_cast<uint32>(Paths.Num()))
+        {
+            *Reader << Paths.AddDefaulted_GetRef();
+        }
+        OutPath = Paths.IsValidIndex(Index) ? Paths[Index] : FString();
+    };
+
+    OutQueries.Reset();
+    while (!Reader->AtEnd() && !Reader->IsError())
+    {
+        FDemuteRecordedSurfaceQuery& Query = OutQueries.AddDefaulted_GetRef();
+        uint8 Channel = 0;
+        uint8 Flags = 0;
+        uint8 Surface = 0;
+
+        *Reader << Query.Time;
+        *Reader << Query.Start;
+        *Reader << Query.End;
+        *Reader << Channel;
+        *Reader << Flags;
+        ReadPath(Query.ActorClass);
+        ReadPath(Query.SurfaceData);
+        *Reader << Query.MetasoundParameter;
+        *Reader << Surface;
+
+        Query.TraceChannel = static_cast<ETraceTypeQuery>(Channel);
+        Query.bTraceComplex = (Flags & TraceComplex) != 0;
+        Query.bHit = (Flags & Hit) != 0;
+        Query.bFoundSurface = (Flags & FoundSurface) != 0;
+        Query.SurfaceType = static_cast<EPhysicalSurface>(Surface);
+    }
+
+    // A session that crashed mid-record leaves a truncated last entry
+    if (Reader->IsError() && OutQueries.Num() > 0)
+    {
+        OutQueries.Pop();
+    }
+
+    return true;
+}
+
+#if DEMUTE_DEBUG_ENABLED
+
+static FAutoConsoleCommandWithWorldAndArgs StartSurfaceQueryRecordingCommand(
+    TEXT("DEMUTE.Record.Start"),
+    TEXT("Record every surface query to a binary file for the DemuteSurfaceQueryReplay commandlet.\nUsage: DEMUTE.Record.Start [File]  (default: Saved/SurfaceQueries/<Map>_<Date>.dsq)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld* World)
+        {
+            if (!World)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("World is null"));
+                return;
+            }
+
+            // Replays load the level itself, not its PIE copy
+            const FString MapName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+
+            FString Filename;
+            if (Args.Num() > 0)
+            {
+                Filename = Args[0];
+            }
+            else
+            {
+                Filename = FPaths::ProjectSavedDir() / TEXT("SurfaceQueries") / FString::Printf(TEXT("%s_%s.dsq"),
+                    *FPaths::GetBaseFilename(MapName), *FDateTime::Now().ToString());
+            }
+
+            FDemuteSurfaceQueryRecorder::Get().Start(Filename, MapName);
+        }
+    )
+);
+
+static FAutoConsoleCommand StopSurfaceQueryRecordingCommand(
+    TEXT("DEMUTE.Record.Stop"),
+    TEXT("Stop recording surface queries"),
+    FConsoleCommandDelegate::CreateLambda(
+        []()
+        {
+            FDemuteSurfaceQueryRecorder::Get().Stop();
+        }
+    )
+);
+
+#endif // DEMUTE_DEBUG_ENABLED
@@ -0,0 +1,208 @@
+#include "DemuteSurfaceQueryReplayCommandlet.h"
+#include "DemuteAudioFunctionLibrary.h"
+#include "DemuteSurfaceQueryRecorder.h"
+#include "AudioSurfaceData.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "UObject/Package.h"
+
+UDemuteSurfaceQueryReplayCommandlet::UDemuteSurfaceQueryReplayCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UDemuteSurfaceQueryReplayCommandlet::Main(const FString& Params)
+{
+    FString RecordingFile;
+    if (!FParse::Value(*Params, TEXT("Recording="), RecordingFile))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Missing -Recording=<File>"));
+        return 1;
+    }
+
+    FString MapName;
+    TArray<FDemuteRecordedSurfaceQuery> Queries;
+    if (!FDemuteSurfaceQueryRecorder::LoadFile(RecordingFile, MapName, Queries))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Cannot read recording '%s'"), *RecordingFile);
+        return 1;
+    }
+
+    FParse::Value(*Params, TEXT("Map="), MapName);
+
+    // Resolver configuration overrides
+    FString SurfaceDataOverridePath;
+    const bool bOverrideSurfaceData = FParse::Value(*Params, TEXT("SurfaceData="), SurfaceDataOverridePath);
+    const bool bFallbackMode = FParse::Param(*Params, TEXT("FallbackMode"));
+    int32 ComplexOverride = INDEX_NONE;
+    FParse::Value(*Params, TEXT("Complex="), ComplexOverride);
+    int32 Iterations = 1;
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    Iterations = FMath::Max(Iterations, 1);
+    int32 MaxDiffs = 20;
+    FParse::Value(*Params, TEXT("MaxDiffs="), MaxDiffs);
+    const bool bFailOnDiff = FParse::Param(*Params, TEXT("FailOnDiff"));
+
+    UAudioSurfaceData* SurfaceDataOverride = bOverrideSurfaceData ? FindSurfaceData(SurfaceDataOverridePath) : nullptr;
+    if (bOverrideSurfaceData && !SurfaceDataOverride)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Cannot load surface data '%s'"), *SurfaceDataOverridePath);
+        return 1;
+    }
+
+    UWorld* World = LoadWorld(MapName);
+    if (!World)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Cannot load map '%s'"), *MapName);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Replaying %d surface queries on %s, %d iteration(s)"), Queries.Num(), *MapName, Iterations);
+
+    TArray<double> QuerySeconds;
+    QuerySeconds.SetNumZeroed(Queries.Num());
+
+    // Queries differing in any way, and the number of differences of each kind
+    int32 DifferingQueries = 0;
+    int32 HitDiffs = 0;
+    int32 SurfaceDiffs = 0;
+    int32 ParameterDiffs = 0;
+    const TArray<AActor*> NoActorsToIgnore;
+
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        for (int32 i = 0; i < Queries.Num(); ++i)
+        {
+            const FDemuteRecordedSurfaceQuery& Query = Queries[i];
+
+            UAudioSurfaceData* SurfaceData = nullptr;
+            if (bOverrideSurfaceData)
+            {
+                SurfaceData = SurfaceDataOverride;
+            }
+            else if (!bFallbackMode && !Query.SurfaceData.IsEmpty())
+            {
+                SurfaceData = FindSurfaceData(Query.SurfaceData);
+            }
+
+            const bool bTraceComplex = ComplexOverride == INDEX_NONE ? Query.bTraceComplex : ComplexOverride != 0;
+
+            int32 MetasoundParameter = -1;
+            TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            const bool bFoundSurface = UDemuteAudioFunctionLibrary::LineTraceForSurfaceTypes(
+                World, Query.Start, Query.End, Query.TraceChannel, bTraceComplex, NoActorsToIgnore, SurfaceData,
+                MetasoundParameter, SurfaceType);
+            QuerySeconds[i] += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+            // Results only change with the configuration, compare them once
+            if (Iteration > 0)
+            {
+                continue;
+            }
+
+            const bool bHitDiff = bFoundSurface != Query.bFoundSurface;
+            const bool bSurfaceDiff = !bHitDiff && bFoundSurface && SurfaceType != Query.SurfaceType;
+            const bool bParameterDiff = !bHitDiff && bFoundSurface && MetasoundParameter != Query.MetasoundParameter;
+            if (!bHitDiff && !bSurfaceDiff && !bParameterDiff)
+            {
+                continue;
+            }
+
+            DifferingQueries++;
+            HitDiffs += bHitDiff ? 1 : 0;
+            SurfaceDiffs += bSurfaceDiff ? 1 : 0;
+            ParameterDiffs += bParameterDiff ? 1 : 0;
+
+            if (DifferingQueries <= MaxDiffs)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Query %d at %.2fs (%s) from %s: recorded %s/%d, replayed %s/%d"),
+                    i, Query.Time, *Query.ActorClass, *Query.Start.ToString(),
+                    Query.bFoundSurface ? *UEnum::GetValueAsString(Query.SurfaceType.GetValue()) : TEXT("none"), Query.MetasoundParameter,
+                    bFoundSurface ? *UEnum::GetValueAsString(SurfaceType.GetValue()) : TEXT("none"), MetasoundParameter);
+            }
+        }
+    }
+
+    if (Queries.Num() > 0)
+    {
+        double TotalSeconds = 0.0;
+        for (double& Seconds : QuerySeconds)
+        {
+            Seconds /= Iterations;
+            TotalSeconds += Seconds;
+        }
+
+        QuerySeconds.Sort();
+        auto Percentile = [&QuerySeconds](double Fraction)
+        {
+            return QuerySeconds[FMath::Min(FMath::FloorToInt(Fraction * QuerySeconds.Num()), QuerySeconds.Num() - 1)] * 1000000.0;
+        };
+
+        UE_LOG(LogTemp, Display, TEXT("Timing: total %.3f ms, average %.2f us, median %.2f us, p95 %.2f us, max %.2f us"),
+            TotalSeconds * 1000.0, TotalSeconds * 1000000.0 / Queries.Num(), Percentile(0.5), Percentile(0.95), Percentile(1.0));
+    }
+
+    // A query can differ both in surface and parameter, so the breakdown can add up to more than DifferingQueries
+    UE_LOG(LogTemp, Display, TEXT("Results: %d of %d queries differ (found/missed: %d, surface: %d, parameter: %d)"),
+        DifferingQueries, Queries.Num(), HitDiffs, SurfaceDiffs, ParameterDiffs);
+
+    World->DestroyWorld(false);
+    World->RemoveFromRoot();
+
+    return bFailOnDiff && DifferingQueries > 0 ? 1 : 0;
+}
+
+UWorld* UDemuteSurfaceQueryReplayCommandlet::LoadWorld(const FString& MapName) const
+{
+    UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+    UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    World->AddToRoot();
+    World->WorldType = EWorldType::Editor;
+
+    if (!World->bIsWorldInitialized)
+    {
+        World->InitWorld(UWorld::InitializationValues()
+            .AllowAudioPlayback(false)
+            .CreatePhysicsScene(true)
+            .RequiresHitProxies(false)
+            .CreateNavigation(false)
+            .CreateAISystem(false)
+            .ShouldSimulatePhysics(false)
+            .SetTransactional(false));
+    }
+
+    World->UpdateWorldComponents(true, false);
+    World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+    // One tick lets the physics scene build its acceleration structure before the first trace
+    World->Tick(LEVELTICK_All, 0.0f);
+
+    return World;
+}
+
+UAudioSurfaceData* UDemuteSurfaceQueryReplayCommandlet::FindSurfaceData(const FString& Path)
+{
+    if (TObjectPtr<UAudioSurfaceData>* Loaded = LoadedSurfaceData.Find(Path))
+    {
+        return *Loaded;
+    }
+
+    UAudioSurfaceData* SurfaceData = LoadObject<UAudioSurfaceData>(nullptr, *Path);
+    if (!SurfaceData)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot load surface data '%s', replaying in fallback mode"), *Path);
+    }
+
+    LoadedSurfaceData.Add(Path, SurfaceData);
+    return SurfaceData;
+}
@@ -0,0 +1,16 @@
+#include "DemuteSurfaceSettings.h"
+
+UDemuteSurfaceSettings::UDemuteSurfaceSettings()
+{
+    CategoryName = TEXT("Plugins");
+}
+
+const FDemuteSurfacePerformancePolicy& UDemuteSurfaceSettings::GetPolicy() const
+{
+    if (const FDemuteSurfacePerformancePolicy* Override = PlatformOverrides.Find(FPlatformProperties::IniPlatformName()))
+    {
+        return *Override;
+    }
+
+    return DefaultPolicy;
+}
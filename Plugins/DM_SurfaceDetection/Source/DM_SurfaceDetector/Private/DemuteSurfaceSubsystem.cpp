@@ -0,0 +1,1078 @@
+#include "DemuteSurfaceSubsystem.h"
+#include "DemuteAudioFunctionLibrary.h"
+#include "DemuteDebugSubsystem.h"
+#include "DemuteFootstepCsvStats.h"
+#include "DemuteGroundProbeComponent.h"
+#include "DemuteSurfaceSettings.h"
+#include "Animation/AnimSequenceBase.h"
+#include "AudioDevice.h"
+#include "Components/AudioComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Quartz/AudioMixerClockHandle.h"
+#include "Quartz/QuartzSubsystem.h"
+#include "Sound/SoundBase.h"
+
+CSV_DEFINE_CATEGORY(DemuteFootsteps, true);
+
+namespace DemuteFootstepTiming
+{
+    // How far a footstep can land from its predicted contact time and still be that contact
+    static constexpr double PredictionTimingWindow = 0.25;
+
+    // How long a prediction is kept past its contact and lead time in case its footstep comes late
+    static constexpr double PredictionExpiryMargin = 0.5;
+
+    // Longest time between two footsteps of a mesh for the play rate to be measured from them
+    static constexpr double MaxPlayRateMeasureInterval = 2.0;
+
+    // The Quartz clock runs a 1 ms thirty-second note: 60 s / 7500 beats / 8
+    static constexpr float ClockBeatsPerMinute = 7500.0f;
+    static constexpr double ClockResolution = 0.001;
+
+    // How long footstep counters keep being collected after the Gameplay Debugger last showed them
+    static constexpr double StatsKeepAliveTime = 2.0;
+}
+
+void UDemuteSurfaceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    PendingRequests.Empty();
+    PendingCrowdRequests.Empty();
+    ActiveVoices.Empty();
+    ActorSurfaceStates.Empty();
+    FootstepStats.Empty();
+    CrowdClusters.Empty();
+    CrowdCells.Empty();
+    CrowdWindowElapsed = 0.0f;
+    CulledFootstepCount = 0;
+    ParameterBatch.Reset();
+    QueryHistory.Reset();
+    AsyncRequests.Empty();
+    Predictions.Empty();
+    FootstepPhases.Empty();
+
+    ApplyPolicy(UDemuteSurfaceSettings::Get()->GetPolicy());
+    AsyncTraceDelegate.BindUObject(this, &UDemuteSurfaceSubsystem::OnAsyncTraceDone);
+    PredictionTraceDelegate.BindUObject(this, &UDemuteSurfaceSubsystem::OnPredictionTraceDone);
+}
+
+void UDemuteSurfaceSubsystem::ApplyPolicy(const FDemuteSurfacePerformancePolicy& Policy)
+{
+    MaxFootstepsPerFrame = Policy.MaxFootstepsPerFrame;
+    MaxActiveFootstepVoices = Policy.MaxActiveFootstepVoices;
+    MaxCrowdRefreshTracesPerFrame = Policy.MaxCrowdRefreshTracesPerFrame;
+    FullPriorityDistance = Policy.FullPriorityDistance;
+    MaxAudibleDistance = Policy.MaxAudibleDistance;
+    MaxCachedActors = Policy.MaxCachedActors;
+    SurfaceCacheLifetime = Policy.SurfaceCacheLifetime;
+    SurfaceCacheRadius = Policy.SurfaceCacheRadius;
+    ResolvePreference = Policy.ResolvePreference;
+    bUseAsyncTraces = Policy.bUseAsyncTraces;
+    bScheduleWithQuartz = Policy.bScheduleWithQuartz;
+    QuartzScheduleLatency = Policy.QuartzScheduleLatency;
+    bPredictFootsteps = Policy.bPredictFootsteps;
+    PredictionLeadTime = Policy.PredictionLeadTime;
+    PredictionTolerance = Policy.PredictionTolerance;
+    MaxPredictionTracesPerFrame = Policy.MaxPredictionTracesPerFrame;
+}
+
+void UDemuteSurfaceSubsystem::Deinitialize()
+{
+    StopCrowdLoops();
+    ParameterBatch.Reset();
+    PendingRequests.Empty();
+    PendingCrowdRequests.Empty();
+    ActiveVoices.Empty();
+    ActorSurfaceStates.Empty();
+    FootstepStats.Empty();
+    AsyncRequests.Empty();
+    AsyncTraceDelegate.Unbind();
+    Predictions.Empty();
+    FootstepPhases.Empty();
+    PredictionTraceDelegate.Unbind();
+    FootstepClock = nullptr;
+    Super::Deinitialize();
+}
+
+bool UDemuteSurfaceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    // EditorPreview lets footstep notifies play in the animation editor
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::EditorPreview;
+}
+
+TStatId UDemuteSurfaceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDemuteSurfaceSubsystem, STATGROUP_Tickables);
+}
+
+bool UDemuteSurfaceSubsystem::RequestFootstep(const FDemuteFootstepRequest& Request)
+{
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Request);
+
+    if (!Request.Sound)
+    {
+        return false;
+    }
+
+    CSV_CUSTOM_STAT(DemuteFootsteps, Queries, 1, ECsvCustomStatOp::Accumulate);
+
+    FDemuteFootstepStats* Stats = FindOrAddFootstepStats(Request.Instigator);
+    if (Stats)
+    {
+        if (Stats->RequestCount++ == 0)
+        {
+            Stats->FirstRequestTime = GetWorld()->GetTimeSeconds();
+        }
+        Stats->LastSignificance = Request.Significance;
+    }
+
+    // Rank the request now, while it is still cheap: no trace, no voice
+    float DistanceToListener = 0.0f;
+    FVector ListenerLocation;
+    if (GetListenerLocation(ListenerLocation))
+    {
+        DistanceToListener = FVector::Dist(ListenerLocation, Request.Start);
+    }
+
+    const float AudibleDistance = GetAudibleDistance(Request.Sound);
+    if (DistanceToListener > AudibleDistance)
+    {
+        CulledFootstepCount++;
+        CSV_CUSTOM_STAT(DemuteFootsteps, Culled, 1, ECsvCustomStatOp::Accumulate);
+        if (Stats)
+        {
+            Stats->CulledCount++;
+            Stats->LastPriority = 0.0f;
+        }
+        return false;
+    }
+
+    // The surface is unknown until traced, so estimate its loudness from the last one walked on
+    float SurfaceLoudness = 1.0f;
+    if (Request.SurfaceData && Request.Instigator)
+    {
+        if (const FDemuteActorSurfaceState* State = ActorSurfaceStates.Find(Request.Instigator.Get()))
+        {
+            SurfaceLoudness = Request.SurfaceData->GetSurfaceLoudness(State->LastSurfaceType);
+        }
+    }
+
+    const float FalloffDistance = AudibleDistance - FullPriorityDistance;
+    const float DistanceFactor = FalloffDistance > 0.0f ? 1.0f - FMath::Clamp((DistanceToListener - FullPriorityDistance) / FalloffDistance, 0.0f, 1.0f) : 1.0f;
+
+    const bool bCrowdRequest = bEnableCrowdAggregation && Request.bAllowCrowdAggregation && Request.CrowdSound && Request.Instigator;
+
+    FDemuteFootstepRequest& QueuedRequest = bCrowdRequest ? PendingCrowdRequests.Add_GetRef(Request) : PendingRequests.Add_GetRef(Request);
+    QueuedRequest.Priority = DistanceFactor * Request.Significance * SurfaceLoudness;
+
+    // Without a better estimate, the foot touched the ground when the request was made
+    if (QueuedRequest.ContactTime <= 0.0)
+    {
+        QueuedRequest.ContactTime = GetWorld()->GetTimeSeconds();
+    }
+
+    if (Stats)
+    {
+        Stats->LastPriority = QueuedRequest.Priority;
+    }
+
+    return true;
+}
+
+void UDemuteSurfaceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Total);
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Tick);
+
+    PruneFinishedVoices();
+
+    if (Predictions.Num() > 0)
+    {
+        IssueDuePredictions();
+    }
+
+    // Forget the footstep phases of meshes that stopped stepping, they could not measure a play rate anymore
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (auto It = FootstepPhases.CreateIterator(); It; ++It)
+    {
+        if (Now - It.Value().WorldTime > DemuteFootstepTiming::MaxPlayRateMeasureInterval)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Crowd requests first: the ones in uncrowded cells join the regular budget below
+    ProcessCrowdRequests();
+
+    CrowdWindowElapsed += DeltaTime;
+    if (CrowdWindowElapsed >= CrowdWindow)
+    {
+        UpdateCrowdClusters(CrowdWindowElapsed);
+        CrowdWindowElapsed = 0.0f;
+    }
+
+    if (PendingRequests.Num() > 0)
+    {
+        ProcessPendingRequests();
+    }
+
+    // All parameter updates of the frame go to the audio thread in one command
+    ParameterBatch.Flush(GetWorld());
+
+    CSV_CUSTOM_STAT(DemuteFootsteps, ActiveVoices, ActiveVoices.Num(), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(DemuteFootsteps, CrowdClusters, CrowdClusters.Num(), ECsvCustomStatOp::Set);
+
+    if (FDemuteSurfaceQueryHistory::IsRecording())
+    {
+        QueryHistory.Draw(GetWorld());
+    }
+    else if (QueryHistory.Num() > 0)
+    {
+        QueryHistory.Reset();
+    }
+}
+
+void UDemuteSurfaceSubsystem::ProcessPendingRequests()
+{
+    // Best requests first; everything past the budget is culled before tracing
+    PendingRequests.Sort([](const FDemuteFootstepRequest& A, const FDemuteFootstepRequest& B)
+    {
+        return A.Priority > B.Priority;
+    });
+
+    // Footsteps still waiting for their async trace will take a voice too
+    const int32 FreeVoices = FMath::Max(MaxActiveFootstepVoices - ActiveVoices.Num() - AsyncRequests.Num(), 0);
+    const int32 NumToProcess = FMath::Min3(PendingRequests.Num(), MaxFootstepsPerFrame, FreeVoices);
+
+    for (int32 i = 0; i < NumToProcess; ++i)
+    {
+        ProcessRequest(PendingRequests[i]);
+    }
+
+    CulledFootstepCount += PendingRequests.Num() - NumToProcess;
+    CSV_CUSTOM_STAT(DemuteFootsteps, Culled, PendingRequests.Num() - NumToProcess, ECsvCustomStatOp::Accumulate);
+
+#if DEMUTE_DEBUG_ENABLED
+    for (int32 i = NumToProcess; i < PendingRequests.Num(); ++i)
+    {
+        if (FDemuteFootstepStats* Stats = FindOrAddFootstepStats(PendingRequests[i].Instigator))
+        {
+            Stats->DroppedCount++;
+        }
+    }
+#endif
+
+    PendingRequests.Reset();
+}
+
+void UDemuteSurfaceSubsystem::ProcessRequest(FDemuteFootstepRequest& Request)
+{
+    int32 MetasoundParameter = -1;
+
+    // Surface already queried ahead of contact: nothing left to trace
+    if (Predictions.Num() > 0 && ConsumePrediction(Request, MetasoundParameter))
+    {
+        CSV_CUSTOM_STAT(DemuteFootsteps, PredictedResolutions, 1, ECsvCustomStatOp::Accumulate);
+        if (FDemuteFootstepStats* Stats = FindOrAddFootstepStats(Request.Instigator))
+        {
+            Stats->PredictionHitCount++;
+        }
+        StartFootstepVoice(Request, MetasoundParameter);
+        return;
+    }
+
+    // The instigator's ground probe already traced below it this frame (or will, for everyone)
+    if (GetProbedSurface(Request, MetasoundParameter))
+    {
+        CSV_CUSTOM_STAT(DemuteFootsteps, ProbedResolutions, 1, ECsvCustomStatOp::Accumulate);
+        StartFootstepVoice(Request, MetasoundParameter);
+        return;
+    }
+
+    if (ResolvePreference == EDemuteSurfaceResolvePreference::PreferCache && GetCachedSurface(Request, MetasoundParameter))
+    {
+        CSV_CUSTOM_STAT(DemuteFootsteps, CachedResolutions, 1, ECsvCustomStatOp::Accumulate);
+        if (FDemuteFootstepStats* Stats = FindOrAddFootstepStats(Request.Instigator))
+        {
+            Stats->CacheHitCount++;
+        }
+        StartFootstepVoice(Request, MetasoundParameter);
+        return;
+    }
+
+    if (bUseAsyncTraces)
+    {
+        StartAsyncTrace(Request);
+        return;
+    }
+
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+    if (ResolveSurface(Request, MetasoundParameter, SurfaceType))
+    {
+        StartFootstepVoice(Request, MetasoundParameter);
+    }
+}
+
+void UDemuteSurfaceSubsystem::StartFootstepVoice(const FDemuteFootstepRequest& Request, int32 MetasoundParameter)
+{
+    if (UAudioComponent* Voice = PlayFootstepVoice(Request, MetasoundParameter))
+    {
+        CSV_CUSTOM_STAT(DemuteFootsteps, VoicesStarted, 1, ECsvCustomStatOp::Accumulate);
+        ActiveVoices.Add(Voice);
+    }
+}
+
+bool UDemuteSurfaceSubsystem::ResolveSurface(const FDemuteFootstepRequest& Request, int32& OutMetasoundParameter, TEnumAsByte<EPhysicalSurface>& OutSurfaceType)
+{
+    TArray<AActor*> ActorsToIgnore;
+    if (Request.Instigator)
+    {
+        ActorsToIgnore.Add(Request.Instigator);
+    }
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    const bool bFoundSurface = UDemuteAudioFunctionLibrary::LineTraceForSurfaceTypes(
+        GetWorld(),
+        Request.Start,
+        Request.End,
+        Request.TraceChannel,
+        Request.bTraceComplex,
+        ActorsToIgnore,
+        Request.SurfaceData,
+        OutMetasoundParameter,
+        OutSurfaceType
+    );
+
+    OnSurfaceResolved(Request, bFoundSurface, OutMetasoundParameter, OutSurfaceType, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+    return bFoundSurface;
+}
+
+bool UDemuteSurfaceSubsystem::GetProbedSurface(const FDemuteFootstepRequest& Request, int32& OutMetasoundParameter)
+{
+    UDemuteGroundProbeComponent* GroundProbe = Request.Instigator ? Request.Instigator->FindComponentByClass<UDemuteGroundProbeComponent>() : nullptr;
+    if (!GroundProbe || !GroundProbe->MatchesTrace(Request.TraceChannel, Request.bTraceComplex))
+    {
+        return false;
+    }
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    const FDemuteGroundHit& Ground = GroundProbe->GetGround();
+
+    // The probe traces below the actor: only trust it for a foot above the same ground, within the footstep's trace
+    if (!Ground.bHit
+        || Ground.Location.Z < Request.End.Z
+        || FVector::DistSquared2D(Ground.Location, Request.Start) > FMath::Square(GroundProbe->FootstepTolerance))
+    {
+        return false;
+    }
+
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, SurfaceQuery);
+
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+    const bool bFoundSurface = UDemuteAudioFunctionLibrary::GetSurfaceTypeFromHit(Ground.Hit, Request.bTraceComplex, Request.SurfaceData, OutMetasoundParameter, SurfaceType);
+
+    // Recorded as the probe's own trace, which is the one that found this surface
+    UDemuteAudioFunctionLibrary::RecordSurfaceQuery(GetWorld(), Ground.Hit.TraceStart, Ground.Hit.TraceEnd, Request.TraceChannel, Request.bTraceComplex,
+        Request.Instigator, Request.SurfaceData, &Ground.Hit, OutMetasoundParameter, SurfaceType, StartCycles);
+
+    OnSurfaceResolved(Request, bFoundSurface, OutMetasoundParameter, SurfaceType, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+    return bFoundSurface;
+}
+
+void UDemuteSurfaceSubsystem::StartAsyncTrace(const FDemuteFootstepRequest& Request)
+{
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(DemuteFootstepTrace), Request.bTraceComplex, Request.Instigator);
+    QueryParams.bReturnPhysicalMaterial = true;
+
+    // The request travels as user data, the delegate finds it back when the trace is done
+    const uint32 RequestId = NextAsyncRequestId++;
+    AsyncRequests.Add(RequestId, Request);
+
+    GetWorld()->AsyncLineTraceByChannel(
+        EAsyncTraceType::Single,
+        Request.Start,
+        Request.End,
+        UEngineTypes::ConvertToCollisionChannel(Request.TraceChannel),
+        QueryParams,
+        FCollisionResponseParams::DefaultResponseParam,
+        &AsyncTraceDelegate,
+        RequestId
+    );
+}
+
+void UDemuteSurfaceSubsystem::OnAsyncTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Total);
+
+    FDemuteFootstepRequest Request;
+    if (!AsyncRequests.RemoveAndCopyValue(TraceDatum.UserData, Request))
+    {
+        return;
+    }
+
+    int32 MetasoundParameter = -1;
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+    bool bFoundSurface = false;
+    {
+        // Only the game thread part of the query: the trace itself ran off the game thread
+        CSV_SCOPED_TIMING_STAT(DemuteFootsteps, SurfaceQuery);
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+
+        const FHitResult* Hit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Candidate) { return Candidate.bBlockingHit; });
+        bFoundSurface = Hit && UDemuteAudioFunctionLibrary::GetSurfaceTypeFromHit(*Hit, Request.bTraceComplex, Request.SurfaceData, MetasoundParameter, SurfaceType);
+
+        UDemuteAudioFunctionLibrary::RecordSurfaceQuery(GetWorld(), Request.Start, Request.End, Request.TraceChannel, Request.bTraceComplex,
+            Request.Instigator, Request.SurfaceData, Hit, MetasoundParameter, SurfaceType, StartCycles);
+    }
+
+    CSV_CUSTOM_STAT(DemuteFootsteps, Traces, 1, ECsvCustomStatOp::Accumulate);
+
+    // The trace ran off the game thread, it has no game thread cost to report
+    OnSurfaceResolved(Request, bFoundSurface, MetasoundParameter, SurfaceType, 0.0);
+
+    if (bFoundSurface)
+    {
+        StartFootstepVoice(Request, MetasoundParameter);
+    }
+}
+
+void UDemuteSurfaceSubsystem::PredictFootstep(USkeletalMeshComponent* MeshComponent, FName SocketName, float TraceLength, ETraceTypeQuery TraceChannel,
+    bool bTraceComplex, UAudioSurfaceData* SurfaceData, const USoundBase* Sound, float TimeToContact)
+{
+    if (!bPredictFootsteps || !MeshComponent || TimeToContact <= 0.0f)
+    {
+        return;
+    }
+
+    // No point predicting footsteps that will be rejected as inaudible, by the same rule as RequestFootstep
+    FVector ListenerLocation;
+    if (GetListenerLocation(ListenerLocation) && FVector::Dist(ListenerLocation, MeshComponent->GetComponentLocation()) > GetAudibleDistance(Sound))
+    {
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    // Chain from the predicted contact of the footstep landing now rather than from the frame time,
+    // so frame quantization does not accumulate from one step to the next
+    double ContactBase = Now;
+    for (auto It = Predictions.CreateIterator(); It; ++It)
+    {
+        if (It.Value().MeshComponent != MeshComponent)
+        {
+            continue;
+        }
+
+        if (FMath::Abs(It.Value().ContactTime - Now) <= DemuteFootstepTiming::PredictionTimingWindow)
+        {
+            ContactBase = It.Value().ContactTime;
+        }
+        else if (It.Value().SocketName == SocketName && It.Value().ContactTime > Now)
+        {
+            // A newer prediction for the same foot replaces the previous one
+            It.RemoveCurrent();
+        }
+    }
+
+    FDemuteFootstepPrediction& Prediction = Predictions.Add(NextPredictionId++);
+    Prediction.MeshComponent = MeshComponent;
+    Prediction.SurfaceData = SurfaceData;
+    Prediction.SocketName = SocketName;
+    Prediction.TraceLength = TraceLength;
+    Prediction.TraceChannel = TraceChannel;
+    Prediction.bTraceComplex = bTraceComplex;
+    Prediction.ContactTime = ContactBase + TimeToContact;
+    Prediction.IssueTime = FMath::Max(Now, Prediction.ContactTime - PredictionLeadTime);
+}
+
+float UDemuteSurfaceSubsystem::MeasureFootstepPlayRate(const USkeletalMeshComponent* MeshComponent, const UAnimSequenceBase* Animation, float AnimationTime)
+{
+    if (!MeshComponent || !Animation)
+    {
+        return 0.0f;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const float PlayLength = Animation->GetPlayLength();
+    FDemuteFootstepPhase& Phase = FootstepPhases.FindOrAdd(MeshComponent);
+
+    float PlayRate = 0.0f;
+    const double WorldDelta = Now - Phase.WorldTime;
+    if (Phase.Animation == TObjectKey<UAnimSequenceBase>(Animation) && WorldDelta > 0.0 && WorldDelta <= DemuteFootstepTiming::MaxPlayRateMeasureInterval && PlayLength > 0.0f)
+    {
+        // Looping locomotion wraps around between the two footsteps
+        float AnimationDelta = AnimationTime - Phase.AnimationTime;
+        if (AnimationDelta <= 0.0f)
+        {
+            AnimationDelta += PlayLength;
+        }
+        PlayRate = static_cast<float>(AnimationDelta / WorldDelta);
+    }
+
+    Phase.Animation = Animation;
+    Phase.AnimationTime = AnimationTime;
+    Phase.WorldTime = Now;
+    return PlayRate;
+}
+
+void UDemuteSurfaceSubsystem::IssueDuePredictions()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    int32 IssuedThisFrame = 0;
+
+    for (auto It = Predictions.CreateIterator(); It; ++It)
+    {
+        FDemuteFootstepPrediction& Prediction = It.Value();
+        USkeletalMeshComponent* MeshComponent = Prediction.MeshComponent.Get();
+
+        // Forget predictions whose foot is gone or which were never consumed
+        if (!MeshComponent || Now > Prediction.ContactTime + PredictionLeadTime + DemuteFootstepTiming::PredictionExpiryMargin)
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        if (Prediction.bIssued || Now < Prediction.IssueTime || IssuedThisFrame >= MaxPredictionTracesPerFrame)
+        {
+            continue;
+        }
+
+        // Extrapolate where the foot lands from the current socket and the owner velocity
+        const AActor* Owner = MeshComponent->GetOwner();
+        const FVector Velocity = Owner ? Owner->GetVelocity() : FVector::ZeroVector;
+        const FVector SocketLocation = Prediction.SocketName.IsNone() ? MeshComponent->GetComponentLocation() : MeshComponent->GetSocketLocation(Prediction.SocketName);
+        Prediction.PredictedLocation = SocketLocation + Velocity * (Prediction.ContactTime - Now);
+
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(DemuteFootstepPrediction), Prediction.bTraceComplex, Owner);
+        QueryParams.bReturnPhysicalMaterial = true;
+
+        // The foot is still in the air, so trace twice as far down
+        GetWorld()->AsyncLineTraceByChannel(
+            EAsyncTraceType::Single,
+            Prediction.PredictedLocation,
+            Prediction.PredictedLocation - FVector(0.0f, 0.0f, Prediction.TraceLength * 2.0f),
+            UEngineTypes::ConvertToCollisionChannel(Prediction.TraceChannel),
+            QueryParams,
+            FCollisionResponseParams::DefaultResponseParam,
+            &PredictionTraceDelegate,
+            It.Key()
+        );
+
+        Prediction.bIssued = true;
+        IssuedThisFrame++;
+    }
+}
+
+void UDemuteSurfaceSubsystem::OnPredictionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Total);
+
+    FDemuteFootstepPrediction* Prediction = Predictions.Find(TraceDatum.UserData);
+    if (!Prediction)
+    {
+        return;
+    }
+
+    USkeletalMeshComponent* MeshComponent = Prediction->MeshComponent.Get();
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+    {
+        // Only the game thread part of the query: the trace itself ran off the game thread
+        CSV_SCOPED_TIMING_STAT(DemuteFootsteps, SurfaceQuery);
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+
+        const FHitResult* Hit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Candidate) { return Candidate.bBlockingHit; });
+        Prediction->bFoundSurface = Hit && UDemuteAudioFunctionLibrary::GetSurfaceTypeFromHit(*Hit, Prediction->bTraceComplex, Prediction->SurfaceData.Get(), Prediction->MetasoundParameter, SurfaceType);
+        Prediction->bDone = true;
+
+        UDemuteAudioFunctionLibrary::RecordSurfaceQuery(GetWorld(), TraceDatum.Start, TraceDatum.End, Prediction->TraceChannel, Prediction->bTraceComplex,
+            MeshComponent ? MeshComponent->GetOwner() : nullptr, Prediction->SurfaceData.Get(), Hit, Prediction->MetasoundParameter, SurfaceType, StartCycles);
+    }
+
+    CSV_CUSTOM_STAT(DemuteFootsteps, Traces, 1, ECsvCustomStatOp::Accumulate);
+
+    if (MeshComponent && MeshComponent->GetOwner())
+    {
+        FDemuteFootstepRequest Request;
+        Request.Instigator = MeshComponent->GetOwner();
+        Request.Foot = Prediction->SocketName;
+        Request.Start = Prediction->PredictedLocation;
+        OnSurfaceResolved(Request, Prediction->bFoundSurface, Prediction->MetasoundParameter, SurfaceType, 0.0);
+    }
+}
+
+bool UDemuteSurfaceSubsystem::ConsumePrediction(FDemuteFootstepRequest& Request, int32& OutMetasoundParameter)
+{
+    const AActor* Instigator = Request.Instigator.Get();
+    if (!Instigator)
+    {
+        return false;
+    }
+
+    // The prediction of this foot closest to now is the one for this contact
+    const double Now = GetWorld()->GetTimeSeconds();
+    uint32 BestId = 0;
+    double BestTimeError = DemuteFootstepTiming::PredictionTimingWindow;
+    const FDemuteFootstepPrediction* Best = nullptr;
+
+    for (const TPair<uint32, FDemuteFootstepPrediction>& Pair : Predictions)
+    {
+        const FDemuteFootstepPrediction& Prediction = Pair.Value;
+        const USkeletalMeshComponent* MeshComponent = Prediction.MeshComponent.Get();
+        if (!MeshComponent || MeshComponent->GetOwner() != Instigator || Prediction.SocketName != Request.Foot)
+        {
+            continue;
+        }
+
+        const double TimeError = FMath::Abs(Prediction.ContactTime - Now);
+        if (TimeError <= BestTimeError)
+        {
+            BestId = Pair.Key;
+            BestTimeError = TimeError;
+            Best = &Prediction;
+        }
+    }
+
+    if (!Best)
+    {
+        return false;
+    }
+
+    // The timing is right even when the surface is not ready or the foot landed elsewhere
+    Request.ContactTime = Best->ContactTime;
+
+    const bool bUsable = Best->bDone
+        && Best->bFoundSurface
+        && Best->SurfaceData.Get() == Request.SurfaceData.Get()
+        && FVector::DistSquared2D(Best->PredictedLocation, Request.Start) <= FMath::Square(PredictionTolerance);
+
+    if (bUsable)
+    {
+        OutMetasoundParameter = Best->MetasoundParameter;
+    }
+
+    // One prediction per contact, whether it was right or not
+    Predictions.Remove(BestId);
+    return bUsable;
+}
+
+void UDemuteSurfaceSubsystem::OnSurfaceResolved(const FDemuteFootstepRequest& Request, bool bFoundSurface, int32 MetasoundParameter, TEnumAsByte<EPhysicalSurface> SurfaceType, double QuerySeconds)
+{
+    if (Request.Instigator)
+    {
+        FDemuteActorSurfaceState& State = ActorSurfaceStates.FindOrAdd(Request.Instigator.Get());
+        State.LastLocation = Request.Start;
+        State.LastTime = GetWorld()->GetTimeSeconds();
+        if (bFoundSurface)
+        {
+            State.LastSurfaceType = SurfaceType;
+            State.LastMetasoundParameter = MetasoundParameter;
+        }
+    }
+
+#if DEMUTE_DEBUG_ENABLED
+    if (FDemuteFootstepStats* Stats = FindOrAddFootstepStats(Request.Instigator))
+    {
+        Stats->QueryCount++;
+        Stats->TotalQuerySeconds += QuerySeconds;
+
+        if (bFoundSurface)
+        {
+            TPair<FName, TEnumAsByte<EPhysicalSurface>>* FootSurface = Stats->LastSurfacePerFoot.FindByPredicate([&Request](const TPair<FName, TEnumAsByte<EPhysicalSurface>>& Entry)
+            {
+                return Entry.Key == Request.Foot;
+            });
+
+            if (FootSurface)
+            {
+                FootSurface->Value = SurfaceType;
+            }
+            else
+            {
+                Stats->LastSurfacePerFoot.Emplace(Request.Foot, SurfaceType);
+            }
+        }
+    }
+#endif
+
+#if DEMUTE_DEBUG_ENABLED
+    UGameInstance* GameInstance = UDemuteDebugSubsystem::IsAnyDebugEnabled() ? GetWorld()->GetGameInstance() : nullptr;
+    if (GameInstance)
+    {
+        if (UDemuteDebugSubsystem* DebugSubsystem = GameInstance->GetSubsystem<UDemuteDebugSubsystem>())
+        {
+            bool bShouldPrint = false;
+            bool bShouldLog = false;
+            DebugSubsystem->ShouldShow(Request.Instigator, bShouldPrint, bShouldLog);
+
+            if (bShouldPrint || bShouldLog)
+            {
+                const FString Message = FString::Printf(TEXT("%s footstep on %s (parameter %d)"),
+                    *GetNameSafe(Request.Instigator),
+                    *UEnum::GetValueAsString(SurfaceType.GetValue()),
+                    MetasoundParameter);
+
+                if (bShouldPrint && GEngine)
+                {
+                    GEngine->AddOnScreenDebugMessage(INDEX_NONE, 2.0f, FColor::Cyan, Message);
+                }
+                if (bShouldLog)
+                {
+                    UE_LOG(LogTemp, Log, TEXT("%s"), *Message);
+                }
+            }
+        }
+    }
+#endif
+}
+
+bool UDemuteSurfaceSubsystem::GetCachedSurface(const FDemuteFootstepRequest& Request, int32& OutMetasoundParameter) const
+{
+    const FDemuteActorSurfaceState* State = ActorSurfaceStates.Find(Request.Instigator.Get());
+    if (!State || State->LastMetasoundParameter < 0)
+    {
+        return false;
+    }
+
+    // Trust the cache while the agent stays close to where it was traced
+    const bool bFresh = GetWorld()->GetTimeSeconds() - State->LastTime <= SurfaceCacheLifetime;
+    const bool bNearby = FVector::DistSquared(State->LastLocation, Request.Start) <= FMath::Square(SurfaceCacheRadius);
+    if (!bFresh || !bNearby)
+    {
+        return false;
+    }
+
+    OutMetasoundParameter = State->LastMetasoundParameter;
+    return true;
+}
+
+void UDemuteSurfaceSubsystem::ProcessCrowdRequests()
+{
+    int32 RefreshTraces = 0;
+
+    for (const FDemuteFootstepRequest& Request : PendingCrowdRequests)
+    {
+        const FIntVector Cell(
+            FMath::FloorToInt(Request.Start.X / CrowdCellSize),
+            FMath::FloorToInt(Request.Start.Y / CrowdCellSize),
+            FMath::FloorToInt(Request.Start.Z / CrowdCellSize));
+
+        FDemuteCrowdCell& CrowdCell = CrowdCells.FindOrAdd(Cell);
+        CrowdCell.CurrentAgents.Add(Request.Instigator.Get());
+
+        // Not a crowd (yet): the footstep plays on its own
+        const int32 Population = FMath::Max(CrowdCell.PreviousAgentCount, CrowdCell.CurrentAgents.Num());
+        if (Population < CrowdMinAgents)
+        {
+            PendingRequests.Add(Request);
+            continue;
+        }
+
+        FDemuteFootstepStats* Stats = FindOrAddFootstepStats(Request.Instigator);
+
+        int32 MetasoundParameter = -1;
+        if (GetCachedSurface(Request, MetasoundParameter))
+        {
+            CSV_CUSTOM_STAT(DemuteFootsteps, CachedResolutions, 1, ECsvCustomStatOp::Accumulate);
+            if (Stats)
+            {
+                Stats->CacheHitCount++;
+            }
+        }
+        else
+        {
+            if (RefreshTraces >= MaxCrowdRefreshTracesPerFrame)
+            {
+                CulledFootstepCount++;
+                CSV_CUSTOM_STAT(DemuteFootsteps, Culled, 1, ECsvCustomStatOp::Accumulate);
+                if (Stats)
+                {
+                    Stats->DroppedCount++;
+                }
+                continue;
+            }
+
+            RefreshTraces++;
+            TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+            if (!ResolveSurface(Request, MetasoundParameter, SurfaceType))
+            {
+                continue;
+            }
+        }
+
+        FDemuteCrowdClusterKey Key;
+        Key.Cell = Cell;
+        Key.MetasoundParameter = MetasoundParameter;
+        Key.CrowdSound = Request.CrowdSound.Get();
+
+        FDemuteCrowdCluster& Cluster = CrowdClusters.FindOrAdd(Key);
+        Cluster.CrowdSound = Request.CrowdSound;
+        Cluster.SurfaceParameterName = Request.SurfaceParameterName;
+        Cluster.LocationSum += Request.Start;
+        Cluster.StepCount++;
+
+        if (Stats)
+        {
+            Stats->AggregatedCount++;
+        }
+    }
+
+    PendingCrowdRequests.Reset();
+}
+
+void UDemuteSurfaceSubsystem::UpdateCrowdClusters(float WindowDuration)
+{
+    for (auto It = CrowdClusters.CreateIterator(); It; ++It)
+    {
+        FDemuteCrowdCluster& Cluster = It.Value();
+        UAudioComponent* Loop = Cluster.LoopComponent.Get();
+        const float Density = Cluster.StepCount / WindowDuration;
+
+        if (Cluster.StepCount > 0)
+        {
+            const FVector Centroid = Cluster.LocationSum / Cluster.StepCount;
+
+            if (!Loop && Cluster.CrowdSound.IsValid())
+            {
+                FAudioDevice::FCreateComponentParams Params(GetWorld());
+                Params.SetLocation(Centroid);
+
+                Loop = FAudioDevice::CreateComponent(Cluster.CrowdSound.Get(), Params);
+                if (Loop)
+                {
+                    Loop->bAutoDestroy = false;
+                    Loop->SetIntParameter(Cluster.SurfaceParameterName, It.Key().MetasoundParameter);
+                    Loop->SetFloatParameter(CrowdDensityParameterName, Density);
+                    Loop->Play();
+
+                    Cluster.LoopComponent = Loop;
+                    CrowdLoopComponents.Add(Loop);
+                }
+            }
+            else if (Loop)
+            {
+                Loop->SetWorldLocation(Centroid);
+                ParameterBatch.Add(Loop, FAudioParameter(CrowdDensityParameterName, Density));
+            }
+
+            Cluster.IdleWindows = 0;
+        }
+        else if (++Cluster.IdleWindows >= 2)
+        {
+            // The crowd left or stopped walking: fade the loop out and let it destroy itself
+            if (Loop)
+            {
+                Loop->bAutoDestroy = true;
+                Loop->FadeOut(WindowDuration, 0.0f);
+                CrowdLoopComponents.Remove(Loop);
+            }
+
+            It.RemoveCurrent();
+            continue;
+        }
+        else if (Loop)
+        {
+            ParameterBatch.Add(Loop, FAudioParameter(CrowdDensityParameterName, 0.0f));
+        }
+
+        Cluster.LocationSum = FVector::ZeroVector;
+        Cluster.StepCount = 0;
+    }
+
+    for (auto It = CrowdCells.CreateIterator(); It; ++It)
+    {
+        FDemuteCrowdCell& CrowdCell = It.Value();
+        if (CrowdCell.PreviousAgentCount == 0 && CrowdCell.CurrentAgents.Num() == 0)
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        CrowdCell.PreviousAgentCount = CrowdCell.CurrentAgents.Num();
+        CrowdCell.CurrentAgents.Reset();
+    }
+}
+
+void UDemuteSurfaceSubsystem::StopCrowdLoops()
+{
+    for (UAudioComponent* Loop : CrowdLoopComponents)
+    {
+        if (IsValid(Loop))
+        {
+            Loop->Stop();
+            Loop->DestroyComponent();
+        }
+    }
+
+    CrowdLoopComponents.Empty();
+    CrowdClusters.Empty();
+    CrowdCells.Empty();
+}
+
+UAudioComponent* UDemuteSurfaceSubsystem::PlayFootstepVoice(const FDemuteFootstepRequest& Request, int32 MetasoundParameter)
+{
+    FAudioDevice::FCreateComponentParams Params(GetWorld(), Request.Instigator);
+    Params.SetLocation(Request.Start);
+
+    UAudioComponent* AudioComponent = FAudioDevice::CreateComponent(Request.Sound, Params);
+    if (!AudioComponent)
+    {
+        return nullptr;
+    }
+
+    // Parameters set before Play travel with the play command, no extra audio thread traffic
+    TArray<FAudioParameter> Parameters;
+    Parameters.Emplace(Request.SurfaceParameterName, MetasoundParameter);
+    if (!Request.IntensityParameterName.IsNone())
+    {
+        Parameters.Emplace(Request.IntensityParameterName, Request.Intensity);
+    }
+
+    AudioComponent->bAutoDestroy = true;
+    AudioComponent->SetParameters(MoveTemp(Parameters));
+
+    // Start the voice a fixed latency after the contact, on the audio clock rather than the game frame
+    const double Delay = Request.ContactTime + QuartzScheduleLatency - GetWorld()->GetTimeSeconds();
+    UQuartzClockHandle* Clock = bScheduleWithQuartz && Delay > 0.0 ? GetFootstepClock() : nullptr;
+    if (Clock)
+    {
+        FQuartzQuantizationBoundary Boundary(
+            EQuartzCommandQuantization::ThirtySecondNote,
+            FMath::Max(1.0f, static_cast<float>(FMath::RoundToDouble(Delay / DemuteFootstepTiming::ClockResolution))),
+            EQuarztQuantizationReference::CurrentTimeRelative);
+
+        AudioComponent->PlayQuantized(this, Clock, Boundary, FOnQuartzCommandEventBP());
+    }
+    else
+    {
+        AudioComponent->Play();
+    }
+
+    return AudioComponent;
+}
+
+UQuartzClockHandle* UDemuteSurfaceSubsystem::GetFootstepClock()
+{
+    if (FootstepClock)
+    {
+        return FootstepClock;
+    }
+
+    UQuartzSubsystem* QuartzSubsystem = GetWorld()->GetSubsystem<UQuartzSubsystem>();
+    if (!QuartzSubsystem)
+    {
+        return nullptr;
+    }
+
+    UQuartzClockHandle* Clock = QuartzSubsystem->CreateNewClock(this, TEXT("DemuteFootsteps"), FQuartzClockSettings(), true);
+    if (!Clock)
+    {
+        return nullptr;
+    }
+
+    // Footsteps only use the clock as a 1 ms grid counted from the time each command arrives
+    Clock->SetBeatsPerMinute(this, FQuartzQuantizationBoundary(), FOnQuartzCommandEventBP(), Clock, DemuteFootstepTiming::ClockBeatsPerMinute);
+    Clock->StartClock(this, Clock);
+
+    FootstepClock = Clock;
+    return FootstepClock;
+}
+
+void UDemuteSurfaceSubsystem::SetVoiceFloatParameter(UAudioComponent* Voice, FName ParameterName, float Value)
+{
+    ParameterBatch.Add(Voice, FAudioParameter(ParameterName, Value));
+}
+
+void UDemuteSurfaceSubsystem::SetVoiceIntParameter(UAudioComponent* Voice, FName ParameterName, int32 Value)
+{
+    ParameterBatch.Add(Voice, FAudioParameter(ParameterName, Value));
+}
+
+void UDemuteSurfaceSubsystem::SetVoiceTriggerParameter(UAudioComponent* Voice, FName ParameterName)
+{
+    FAudioParameter Trigger;
+    Trigger.ParamName = ParameterName;
+    Trigger.ParamType = EAudioParameterType::Trigger;
+    ParameterBatch.Add(Voice, MoveTemp(Trigger));
+}
+
+float UDemuteSurfaceSubsystem::GetAudibleDistance(const USoundBase* Sound) const
+{
+    const float SoundMaxDistance = Sound ? Sound->GetMaxDistance() : WORLD_MAX;
+    return SoundMaxDistance < WORLD_MAX ? SoundMaxDistance : MaxAudibleDistance;
+}
+
+bool UDemuteSurfaceSubsystem::GetListenerLocation(FVector& OutLocation) const
+{
+    const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+    if (!PlayerController)
+    {
+        return false;
+    }
+
+    FVector FrontDir;
+    FVector RightDir;
+    PlayerController->GetAudioListenerPosition(OutLocation, FrontDir, RightDir);
+    return true;
+}
+
+void UDemuteSurfaceSubsystem::PruneFinishedVoices()
+{
+    ActiveVoices.RemoveAllSwap([](const TWeakObjectPtr<UAudioComponent>& Voice)
+    {
+        return !Voice.IsValid() || !Voice->IsPlaying();
+    });
+
+    // Forget actors that were destroyed
+    for (auto It = ActorSurfaceStates.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Over capacity: keep the most recently traced actors
+    if (MaxCachedActors > 0 && ActorSurfaceStates.Num() > MaxCachedActors)
+    {
+        ActorSurfaceStates.ValueSort([](const FDemuteActorSurfaceState& A, const FDemuteActorSurfaceState& B)
+        {
+            return A.LastTime > B.LastTime;
+        });
+
+        int32 Index = 0;
+        for (auto It = ActorSurfaceStates.CreateIterator(); It; ++It)
+        {
+            if (++Index > MaxCachedActors)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    for (auto It = FootstepStats.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+FDemuteFootstepStats* UDemuteSurfaceSubsystem::FindOrAddFootstepStats(const AActor* Actor)
+{
+#if DEMUTE_DEBUG_ENABLED
+    // Counting hashes the actor on every step, so only do it while the counters are looked at
+    const bool bCollectStats = UDemuteDebugSubsystem::IsAnyDebugEnabled()
+        || FPlatformTime::Seconds() - FootstepStatsRequestTime < DemuteFootstepTiming::StatsKeepAliveTime;
+    return Actor && bCollectStats ? &FootstepStats.FindOrAdd(Actor) : nullptr;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,262 @@
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundFacade.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundTrigger.h"
+#include "MetasoundWave.h"
+#include "Math/RandomStream.h"
+
+#define LOCTEXT_NAMESPACE "DemuteSurfaceWaveSelectorNode"
+
+/**
+ * Native replacement for the DEM_Switch_08/16/32_Mono_MSS graphs.
+ *
+ * MetaSounds do not support nested arrays, so the "array of wave arrays" is passed flattened:
+ * all variations of surface 0 first, then all variations of surface 1, and so on.
+ * The Variation Counts array tells the node how many waves belong to each surface.
+ * If Variation Counts is empty, every wave is treated as its own surface (one variation each).
+ *
+ * Example with Variation Counts = [3, 2]:
+ * - Surface 0 picks randomly from Waves[0..2]
+ * - Surface 1 picks randomly from Waves[3..4]
+ */
+namespace Metasound
+{
+    namespace DemuteSurfaceWaveSelectorVertexNames
+    {
+        METASOUND_PARAM(InputTrigger, "Trigger", "Selects a random wave variation for the current surface.");
+        METASOUND_PARAM(InputWaves, "Waves", "All surface variations, laid out surface by surface.");
+        METASOUND_PARAM(InputVariationCounts, "Variation Counts", "Number of variations for each surface, in order. Leave empty for one wave per surface.");
+        METASOUND_PARAM(InputSurfaceIndex, "Surface Index", "The surface to pick from (usually the parameter returned by LineTraceForSurfaceTypes).");
+        METASOUND_PARAM(InputSeed, "Seed", "Seed of the random selection. -1 uses a random seed.");
+
+        METASOUND_PARAM(OutputOnSelected, "On Selected", "Triggered when a wave was selected.");
+        METASOUND_PARAM(OutputOnInvalidSurface, "On Invalid Surface", "Triggered when the surface index has no wave to play.");
+        METASOUND_PARAM(OutputWave, "Wave Asset", "The selected wave variation.");
+        METASOUND_PARAM(OutputWaveIndex, "Wave Index", "Index of the selected wave in the Waves array (-1 if none).");
+    }
+
+    class FDemuteSurfaceWaveSelectorOperator : public TExecutableOperator<FDemuteSurfaceWaveSelectorOperator>
+    {
+    public:
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto InitNodeInfo = []() -> FNodeClassMetadata
+            {
+                FNodeClassMetadata Info;
+                Info.ClassName = { TEXT("Demute"), TEXT("Surface Wave Selector"), TEXT("") };
+                Info.MajorVersion = 1;
+                Info.MinorVersion = 0;
+                Info.DisplayName = LOCTEXT("Metasound_SurfaceWaveSelectorDisplayName", "Surface Wave Selector");
+                Info.Description = LOCTEXT("Metasound_SurfaceWaveSelectorDescription", "Picks a random wave variation for the given surface index. Replaces the 8/16/32-way surface switch graphs.");
+                Info.Author = LOCTEXT("Metasound_DemuteAuthor", "Demute Studio");
+                Info.PromptIfMissing = LOCTEXT("Metasound_DemuteMissingPrompt", "Make sure the DM Surface Detection plugin is enabled.");
+                Info.DefaultInterface = GetVertexInterface();
+                Info.CategoryHierarchy = { LOCTEXT("Metasound_DemuteCategory", "Demute") };
+                return Info;
+            };
+
+            static const FNodeClassMetadata Info = InitNodeInfo();
+            return Info;
+        }
+
+        static const FVertexInterface& GetVertexInterface()
+        {
+            using namespace DemuteSurfaceWaveSelectorVertexNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputTrigger)),
+                    TInputDataVertex<TArray<FWaveAsset>>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWaves)),
+                    TInputDataVertex<TArray<int32>>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputVariationCounts)),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSurfaceIndex), 0),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSeed), -1)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputOnSelected)),
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputOnInvalidSurface)),
+                    TOutputDataVertex<FWaveAsset>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputWave)),
+                    TOutputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputWaveIndex))
+                )
+            );
+
+            return Interface;
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace DemuteSurfaceWaveSelectorVertexNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            return MakeUnique<FDemuteSurfaceWaveSelectorOperator>(
+                InParams.OperatorSettings,
+                InputData.GetOrCreateDefaultDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<TArray<FWaveAsset>>(METASOUND_GET_PARAM_NAME(InputWaves), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<TArray<int32>>(METASOUND_GET_PARAM_NAME(InputVariationCounts), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputSurfaceIndex), InParams.OperatorSettings),
+                InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputSeed), InParams.OperatorSettings)
+            );
+        }
+
+        FDemuteSurfaceWaveSelectorOperator(
+            const FOperatorSettings& InSettings,
+            const FTriggerReadRef& InTrigger,
+            const TDataReadReference<TArray<FWaveAsset>>& InWaves,
+            const TDataReadReference<TArray<int32>>& InVariationCounts,
+            const FInt32ReadRef& InSurfaceIndex,
+            const FInt32ReadRef& InSeed)
+            : TriggerInput(InTrigger)
+            , WavesInput(InWaves)
+            , VariationCountsInput(InVariationCounts)
+            , SurfaceIndexInput(InSurfaceIndex)
+            , SeedInput(InSeed)
+            , OnSelectedOutput(FTriggerWriteRef::CreateNew(InSettings))
+            , OnInvalidSurfaceOutput(FTriggerWriteRef::CreateNew(InSettings))
+            , WaveOutput(TDataWriteReferenceFactory<FWaveAsset>::CreateAny(InSettings))
+            , WaveIndexOutput(FInt32WriteRef::CreateNew(INDEX_NONE))
+        {
+            ResetRandomStream();
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace DemuteSurfaceWaveSelectorVertexNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), TriggerInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputWaves), WavesInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputVariationCounts), VariationCountsInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSurfaceIndex), SurfaceIndexInput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSeed), SeedInput);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace DemuteSurfaceWaveSelectorVertexNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputOnSelected), OnSelectedOutput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputOnInvalidSurface), OnInvalidSurfaceOutput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputWave), WaveOutput);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputWaveIndex), WaveIndexOutput);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            OnSelectedOutput->Reset();
+            OnInvalidSurfaceOutput->Reset();
+            *WaveOutput = FWaveAsset();
+            *WaveIndexOutput = INDEX_NONE;
+            ResetRandomStream();
+        }
+
+        void Execute()
+        {
+            OnSelectedOutput->AdvanceBlock();
+            OnInvalidSurfaceOutput->AdvanceBlock();
+
+            if (*SeedInput != CurrentSeed)
+            {
+                ResetRandomStream();
+            }
+
+            TriggerInput->ExecuteBlock(
+                [](int32, int32) {},
+                [this](int32 StartFrame, int32 EndFrame)
+                {
+                    const int32 WaveIndex = SelectWaveIndex();
+                    if (WaveIndex == INDEX_NONE)
+                    {
+                        *WaveIndexOutput = INDEX_NONE;
+                        OnInvalidSurfaceOutput->TriggerFrame(StartFrame);
+                        return;
+                    }
+
+                    *WaveOutput = (*WavesInput)[WaveIndex];
+                    *WaveIndexOutput = WaveIndex;
+                    OnSelectedOutput->TriggerFrame(StartFrame);
+                }
+            );
+        }
+
+    private:
+        /** Returns the index in the Waves array of a random variation of the current surface, or INDEX_NONE */
+        int32 SelectWaveIndex()
+        {
+            const TArray<FWaveAsset>& Waves = *WavesInput;
+            const TArray<int32>& VariationCounts = *VariationCountsInput;
+            const int32 SurfaceIndex = *SurfaceIndexInput;
+
+            if (SurfaceIndex < 0 || Waves.Num() == 0)
+            {
+                return INDEX_NONE;
+            }
+
+            // No layout given: one wave per surface
+            if (VariationCounts.Num() == 0)
+            {
+                return Waves.IsValidIndex(SurfaceIndex) ? SurfaceIndex : INDEX_NONE;
+            }
+
+            if (!VariationCounts.IsValidIndex(SurfaceIndex))
+            {
+                return INDEX_NONE;
+            }
+
+            int32 FirstWaveIndex = 0;
+            for (int32 i = 0; i < SurfaceIndex; ++i)
+            {
+                FirstWaveIndex += FMath::Max(VariationCounts[i], 0);
+            }
+
+            // Clamp to the waves actually provided so a wrong count never reads out of bounds
+            const int32 NumVariations = FMath::Min(FMath::Max(VariationCounts[SurfaceIndex], 0), Waves.Num() - FirstWaveIndex);
+            if (NumVariations <= 0)
+            {
+                return INDEX_NONE;
+            }
+
+            return FirstWaveIndex + RandomStream.RandRange(0, NumVariations - 1);
+        }
+
+        void ResetRandomStream()
+        {
+            CurrentSeed = *SeedInput;
+            if (CurrentSeed == -1)
+            {
+                RandomStream.GenerateNewSeed();
+            }
+            else
+            {
+                RandomStream.Initialize(CurrentSeed);
+            }
+        }
+
+        FTriggerReadRef TriggerInput;
+        TDataReadReference<TArray<FWaveAsset>> WavesInput;
+        TDataReadReference<TArray<int32>> VariationCountsInput;
+        FInt32ReadRef SurfaceIndexInput;
+        FInt32ReadRef SeedInput;
+
+        FTriggerWriteRef OnSelectedOutput;
+        FTriggerWriteRef OnInvalidSurfaceOutput;
+        TDataWriteReference<FWaveAsset> WaveOutput;
+        FInt32WriteRef WaveIndexOutput;
+
+        FRandomStream RandomStream;
+        int32 CurrentSeed = -1;
+    };
+
+    class FDemuteSurfaceWaveSelectorNode : public FNodeFacade
+    {
+    public:
+        FDemuteSurfaceWaveSelectorNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FDemuteSurfaceWaveSelectorOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FDemuteSurfaceWaveSelectorNode)
+}
+
+#undef LOCTEXT_NAMESPACE
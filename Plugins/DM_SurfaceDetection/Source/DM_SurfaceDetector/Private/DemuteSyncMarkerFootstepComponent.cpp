@@ -0,0 +1,150 @@
+#include "DemuteSyncMarkerFootstepComponent.h"
+#include "DemuteFootstepCsvStats.h"
+#include "DemuteProceduralFootstepComponent.h"
+#include "DemuteSurfaceSubsystem.h"
+#include "DemuteSurfaceSettings.h"
+#include "Animation/AnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+
+UDemuteSyncMarkerFootstepComponent::UDemuteSyncMarkerFootstepComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+void UDemuteSyncMarkerFootstepComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (const AActor* Owner = GetOwner())
+    {
+        Mesh = Owner->FindComponentByClass<USkeletalMeshComponent>();
+    }
+
+    // Reads the sync group once the animation of the frame has been updated
+    if (Mesh)
+    {
+        AddTickPrerequisiteComponent(Mesh);
+    }
+}
+
+void UDemuteSyncMarkerFootstepComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    CSV_SCOPED_TIMING_STAT(DemuteFootsteps, Total);
+
+    const UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+    if (!AnimInstance)
+    {
+        return;
+    }
+
+    // Position of the group leader between its markers, the same whatever the blend
+    const FMarkerSyncAnimPosition Position = AnimInstance->GetSyncGroupPosition(SyncGroupName);
+    if (!Position.IsValid())
+    {
+        PreviousPosition = FMarkerSyncAnimPosition();
+        return;
+    }
+
+    // The markers passed before this component was following the group are not footsteps
+    if (PreviousPosition.IsValid())
+    {
+        const bool bSameMarkers = Position.PreviousMarkerName == PreviousPosition.PreviousMarkerName
+            && Position.NextMarkerName == PreviousPosition.NextMarkerName;
+
+        if (bSameMarkers)
+        {
+            // A jump across most of the segment means a whole cycle went by, e.g. with a single marker.
+            // Smaller moves only give the direction of play, which a reverse playing leader moves in on every tick.
+            static constexpr float CycleJump = 0.5f;
+            const float Move = Position.PositionBetweenMarkers - PreviousPosition.PositionBetweenMarkers;
+            if (FMath::Abs(Move) > CycleJump)
+            {
+                bPlayingBackwards = Move > 0.0f;
+                RequestPassedSteps(Position);
+            }
+            else if (Move != 0.0f)
+            {
+                bPlayingBackwards = Move < 0.0f;
+            }
+        }
+        else
+        {
+            // Positions are in asset time: backwards, the group leaves its segment through the previous marker.
+            // With two markers both ends match, and the direction seen on previous ticks is kept.
+            const bool bEnteredNext = Position.PreviousMarkerName == PreviousPosition.NextMarkerName;
+            const bool bEnteredPrevious = Position.NextMarkerName == PreviousPosition.PreviousMarkerName;
+            if (bEnteredNext != bEnteredPrevious)
+            {
+                bPlayingBackwards = bEnteredPrevious;
+            }
+            RequestPassedSteps(Position);
+        }
+    }
+
+    MarkerSuccessors.Add(Position.PreviousMarkerName, Position.NextMarkerName);
+    PreviousPosition = Position;
+}
+
+void UDemuteSyncMarkerFootstepComponent::RequestPassedSteps(const FMarkerSyncAnimPosition& Position)
+{
+    // Bounds the walk along the marker sequence when the learned successors do not lead to the current marker
+    static constexpr int32 MaxMarkersPerTick = 8;
+
+    // The first marker passed is the one the group was heading to, and the last one is behind it now.
+    // Markers in between, passed within the same tick, follow the sequence seen on previous ticks, read in reverse when playing backwards.
+    FName Marker = bPlayingBackwards ? PreviousPosition.PreviousMarkerName : PreviousPosition.NextMarkerName;
+    const FName LastMarker = bPlayingBackwards ? Position.NextMarkerName : Position.PreviousMarkerName;
+    RequestStep(Marker);
+
+    for (int32 Count = 1; Marker != LastMarker && Count < MaxMarkersPerTick; ++Count)
+    {
+        const FName* NextMarker = bPlayingBackwards ? MarkerSuccessors.FindKey(Marker) : MarkerSuccessors.Find(Marker);
+        Marker = NextMarker ? *NextMarker : LastMarker;
+        RequestStep(Marker);
+    }
+}
+
+void UDemuteSyncMarkerFootstepComponent::RequestStep(FName Marker)
+{
+    const FName* Foot = MarkerFeet.Find(Marker);
+    UWorld* World = GetWorld();
+    UDemuteSurfaceSubsystem* SurfaceSubsystem = World ? World->GetSubsystem<UDemuteSurfaceSubsystem>() : nullptr;
+    if (!Foot || !Metasound || !SurfaceSubsystem)
+    {
+        return;
+    }
+
+    // Keeps procedural footsteps in phase, and leaves them the footstep while they are generated
+    if (UDemuteProceduralFootstepComponent* ProceduralFootsteps = GetOwner()->FindComponentByClass<UDemuteProceduralFootstepComponent>())
+    {
+        if (!ProceduralFootsteps->NotifyAnimFootstep(*Foot))
+        {
+            return;
+        }
+    }
+
+    const FVector Start = Foot->IsNone() ? Mesh->GetComponentLocation() : Mesh->GetSocketLocation(*Foot);
+
+    const FDemuteSurfacePerformancePolicy& Policy = UDemuteSurfaceSettings::Get()->GetPolicy();
+
+    FDemuteFootstepRequest Request;
+    Request.Instigator = GetOwner();
+    Request.Foot = *Foot;
+    Request.Start = Start;
+    Request.End = Start - FVector(0.0f, 0.0f, bUseProjectTraceSettings ? Policy.TraceLength : TraceLength);
+    Request.TraceChannel = bUseProjectTraceSettings ? Policy.TraceChannel : TraceChannel;
+    Request.bTraceComplex = bUseProjectTraceSettings ? Policy.bTraceComplex : bTraceComplex;
+    Request.SurfaceData = AudioSurfaceData;
+    Request.Sound = Metasound;
+    Request.SurfaceParameterName = SurfaceParameterName;
+    Request.Significance = Significance;
+    Request.bAllowCrowdAggregation = bAllowCrowdAggregation;
+    Request.CrowdSound = CrowdSound;
+
+    CSV_CUSTOM_STAT(DemuteFootsteps, SyncMarkerFootsteps, 1, ECsvCustomStatOp::Accumulate);
+    SurfaceSubsystem->RequestFootstep(Request);
+}
@@ -0,0 +1,114 @@
+#include "GameplayDebuggerCategory_DemuteFootsteps.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "DemuteSurfaceSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+FGameplayDebuggerCategory_DemuteFootsteps::FGameplayDebuggerCategory_DemuteFootsteps()
+{
+    SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_DemuteFootsteps::MakeInstance()
+{
+    return MakeShareable(new FGameplayDebuggerCategory_DemuteFootsteps());
+}
+
+void FGameplayDebuggerCategory_DemuteFootsteps::FRepData::Serialize(FArchive& Ar)
+{
+    Ar << ActorName;
+    Ar << bHasStats;
+    Ar << FootSurfaces;
+    Ar << QueryRate;
+    Ar << CacheHitRatio;
+    Ar << PredictionHitCount;
+    Ar << AverageQueryCostMicroseconds;
+    Ar << Significance;
+    Ar << Priority;
+    Ar << RequestCount;
+    Ar << QueryCount;
+    Ar << CulledCount;
+    Ar << DroppedCount;
+    Ar << AggregatedCount;
+}
+
+void FGameplayDebuggerCategory_DemuteFootsteps::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+    DataPack = FRepData();
+
+    if (!DebugActor)
+    {
+        return;
+    }
+
+    DataPack.ActorName = DebugActor->GetName();
+
+    UWorld* World = DebugActor->GetWorld();
+    UDemuteSurfaceSubsystem* SurfaceSubsystem = World ? World->GetSubsystem<UDemuteSurfaceSubsystem>() : nullptr;
+    if (SurfaceSubsystem)
+    {
+        SurfaceSubsystem->KeepFootstepStats();
+    }
+
+    const FDemuteFootstepStats* Stats = SurfaceSubsystem ? SurfaceSubsystem->GetFootstepStats(DebugActor) : nullptr;
+    if (!Stats)
+    {
+        return;
+    }
+
+    DataPack.bHasStats = true;
+
+    for (const TPair<FName, TEnumAsByte<EPhysicalSurface>>& FootSurface : Stats->LastSurfacePerFoot)
+    {
+        const FString FootName = FootSurface.Key.IsNone() ? TEXT("(no socket)") : FootSurface.Key.ToString();
+        DataPack.FootSurfaces.Add(FString::Printf(TEXT("%s: %s"), *FootName, *UEnum::GetValueAsString(FootSurface.Value.GetValue())));
+    }
+
+    const double Elapsed = World->GetTimeSeconds() - Stats->FirstRequestTime;
+    const int32 SurfaceLookups = Stats->QueryCount + Stats->CacheHitCount;
+
+    DataPack.QueryRate = Elapsed > 0.0 ? static_cast<float>(Stats->QueryCount / Elapsed) : 0.0f;
+    DataPack.CacheHitRatio = SurfaceLookups > 0 ? static_cast<float>(Stats->CacheHitCount) / SurfaceLookups : 0.0f;
+    DataPack.AverageQueryCostMicroseconds = Stats->QueryCount > 0 ? static_cast<float>(Stats->TotalQuerySeconds * 1000000.0 / Stats->QueryCount) : 0.0f;
+    DataPack.PredictionHitCount = Stats->PredictionHitCount;
+    DataPack.Significance = Stats->LastSignificance;
+    DataPack.Priority = Stats->LastPriority;
+    DataPack.RequestCount = Stats->RequestCount;
+    DataPack.QueryCount = Stats->QueryCount;
+    DataPack.CulledCount = Stats->CulledCount;
+    DataPack.DroppedCount = Stats->DroppedCount;
+    DataPack.AggregatedCount = Stats->AggregatedCount;
+}
+
+void FGameplayDebuggerCategory_DemuteFootsteps::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+    if (DataPack.ActorName.IsEmpty())
+    {
+        CanvasContext.Printf(TEXT("{grey}Select an actor to see its footsteps"));
+        return;
+    }
+
+    if (!DataPack.bHasStats)
+    {
+        CanvasContext.Printf(TEXT("{white}%s: {grey}no footstep requested yet"), *DataPack.ActorName);
+        return;
+    }
+
+    CanvasContext.Printf(TEXT("{white}Footsteps of {yellow}%s"), *DataPack.ActorName);
+
+    for (const FString& FootSurface : DataPack.FootSurfaces)
+    {
+        CanvasContext.Printf(TEXT("  {white}Last surface {green}%s"), *FootSurface);
+    }
+
+    CanvasContext.Printf(TEXT("{white}Queries: {yellow}%d {white}(%.1f/s)  Avg cost: {yellow}%.1f us"),
+        DataPack.QueryCount, DataPack.QueryRate, DataPack.AverageQueryCostMicroseconds);
+    CanvasContext.Printf(TEXT("{white}Cache hit ratio: {yellow}%.0f%%  {white}Predicted: {yellow}%d"), DataPack.CacheHitRatio * 100.0f, DataPack.PredictionHitCount);
+    CanvasContext.Printf(TEXT("{white}Significance: {yellow}%.2f {white}Last priority: {yellow}%.2f"), DataPack.Significance, DataPack.Priority);
+    CanvasContext.Printf(TEXT("{white}Requests: {yellow}%d  {white}Culled: {red}%d  {white}Dropped: {red}%d  {white}Aggregated: {cyan}%d"),
+        DataPack.RequestCount, DataPack.CulledCount, DataPack.DroppedCount, DataPack.AggregatedCount);
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
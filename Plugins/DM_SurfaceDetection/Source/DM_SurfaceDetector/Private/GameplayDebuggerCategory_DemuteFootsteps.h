@@ -0,0 +1,48 @@
+#pragma once
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "CoreMinimal.h"
+#include "GameplayDebuggerCategory.h"
+
+/**
+ * Gameplay Debugger category showing the footstep surface detection of the selected actor:
+ * last surface per foot, query rate and cost, surface cache hits, significance and budget losses.
+ *
+ * Open the Gameplay Debugger (apostrophe key), select an actor and toggle the DemuteFootsteps category.
+ */
+class FGameplayDebuggerCategory_DemuteFootsteps : public FGameplayDebuggerCategory
+{
+public:
+    FGameplayDebuggerCategory_DemuteFootsteps();
+
+    virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+    virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+
+    static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+protected:
+    struct FRepData
+    {
+        FString ActorName;
+        bool bHasStats = false;
+        TArray<FString> FootSurfaces;
+        float QueryRate = 0.0f;
+        float CacheHitRatio = 0.0f;
+        int32 PredictionHitCount = 0;
+        float AverageQueryCostMicroseconds = 0.0f;
+        float Significance = 0.0f;
+        float Priority = 0.0f;
+        int32 RequestCount = 0;
+        int32 QueryCount = 0;
+        int32 CulledCount = 0;
+        int32 DroppedCount = 0;
+        int32 AggregatedCount = 0;
+
+        void Serialize(FArchive& Ar);
+    };
+
+    FRepData DataPack;
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
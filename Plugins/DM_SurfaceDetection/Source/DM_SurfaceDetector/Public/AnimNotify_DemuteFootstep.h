@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "Engine/EngineTypes.h"
+#include "AnimNotify_DemuteFootstep.generated.h"
+
+class UAudioSurfaceData;
+class UDemuteSurfaceSubsystem;
+class USoundBase;
+struct FDemuteSurfacePerformancePolicy;
+
+/**
+ * C++ footstep notify, going through the footstep voice budget of UDemuteSurfaceSubsystem.
+ *
+ * Same settings as the AN_Footstep_Surface_MetaSoundParam Blueprint, but the trace only runs
+ * if the footstep survives the budget, so culled footsteps cost almost nothing.
+ */
+UCLASS(meta = (DisplayName = "Demute Footstep"))
+class DM_SURFACEDETECTOR_API UAnimNotify_DemuteFootstep : public UAnimNotify
+{
+    GENERATED_BODY()
+
+public:
+    /** Optional curated surface map (leave null to use Project Settings surfaces) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    TObjectPtr<UAudioSurfaceData> AudioSurfaceData;
+
+    /** Sound to play, usually a MetaSound reading the surface parameter */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    TObjectPtr<USoundBase> Metasound;
+
+    /** Name of the int parameter receiving the surface value */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    FName SurfaceParameterName = TEXT("Surface");
+
+    /** Foot bone or socket the trace starts from */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    FName SocketName;
+
+    /** Uses the trace length, channel and complexity of the project settings (Demute Surface Detection) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    bool bUseProjectTraceSettings = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep", meta = (EditCondition = "!bUseProjectTraceSettings"))
+    TEnumAsByte<ETraceTypeQuery> TraceChannel = TraceTypeQuery1;
+
+    /** Distance to trace below the socket */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep", meta = (ClampMin = "0.0", Units = "cm", EditCondition = "!bUseProjectTraceSettings"))
+    float TraceLength = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep", meta = (EditCondition = "!bUseProjectTraceSettings"))
+    bool bTraceComplex = false;
+
+    /** Importance of this footstep in the voice budget (e.g. lower it on background NPC animations) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep", meta = (ClampMin = "0.0"))
+    float Significance = 1.0f;
+
+    /** Queries the surface of the next Demute Footstep of this animation before it lands (if prediction is enabled in the project settings) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    bool bPredictNextFootstep = true;
+
+    /** Lets this footstep be merged into a crowd loop when many characters walk nearby */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep|Crowd")
+    bool bAllowCrowdAggregation = false;
+
+    /** Looping MetaSound with a Density parameter (steps per second), played instead of individual footsteps in crowds */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep|Crowd", meta = (EditCondition = "bAllowCrowdAggregation"))
+    TObjectPtr<USoundBase> CrowdSound;
+
+    virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+    virtual FString GetNotifyName_Implementation() const override;
+
+private:
+    /** Schedules the surface query of the next footstep notify of the animation, from its time and the play rate */
+    void PredictNextFootstep(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference,
+        UDemuteSurfaceSubsystem& SurfaceSubsystem, const FDemuteSurfacePerformancePolicy& Policy) const;
+};
@@ -39,6 +39,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Surface")
     TMap<TEnumAsByte<EPhysicalSurface>, int32> SurfaceTypeMap;
 
+    /**
+     * Relative loudness of each surface, used by the footstep voice budget to rank requests.
+     * Louder surfaces (metal, wood) win over quieter ones (grass, carpet) when the budget is full.
+     * Surfaces not in this map have a loudness of 1.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Surface|Budget", meta = (ClampMin = "0.0"))
+    TMap<TEnumAsByte<EPhysicalSurface>, float> SurfaceLoudnessMap;
+
     /**
      * Checks if a given surface type exists in the map.
      * @param SurfaceType The surface type to check
@@ -55,6 +63,14 @@ public:
     UFUNCTION(BlueprintPure, Category = "Audio Surface")
     int32 GetMetasoundParameter(TEnumAsByte<EPhysicalSurface> SurfaceType) const;
 
+    /**
+     * Gets the relative loudness of a given surface type.
+     * @param SurfaceType The surface type to look up
+     * @return The loudness from SurfaceLoudnessMap, or 1 if not found
+     */
+    UFUNCTION(BlueprintPure, Category = "Audio Surface|Budget")
+    float GetSurfaceLoudness(TEnumAsByte<EPhysicalSurface> SurfaceType) const;
+
 #if WITH_EDITOR
     /**
      * Called after a property is changed in the editor.
@@ -8,6 +8,8 @@
 #include "AudioSurfaceData.h"
 #include "DemuteAudioFunctionLibrary.generated.h"
 
+class UDemuteGroundProbeComponent;
+
 /**
  * Blueprint Function Library for audio-related utility functions.
  * Provides surface detection functionality for dynamic footstep and foley audio systems.
@@ -66,7 +68,69 @@ public:
         TEnumAsByte<EPhysicalSurface>& OutSurfaceType
     );
 
+    /**
+     * Resolves the surface of an existing hit, with the same rules as LineTraceForSurfaceTypes.
+     * Use it with your own (or asynchronous) traces; the hit must be traced with physical materials returned.
+     *
+     * @param HitResult The blocking hit to resolve
+     * @param bTraceComplex Whether the hit comes from a complex trace (uses the hit physical material directly)
+     * @param SurfaceData Optional data asset containing the map of valid surface types (leave null to use Project Settings)
+     * @param OutMetasoundParameter The Metasound parameter value for the surface (-1 if no valid surface found)
+     * @param OutSurfaceType The surface type that was selected (SurfaceType_Default if none found)
+     * @return True if a valid surface type was found, false otherwise
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Physical Material")
+    static bool GetSurfaceTypeFromHit(
+        const FHitResult& HitResult,
+        bool bTraceComplex,
+        UAudioSurfaceData* SurfaceData,
+        int32& OutMetasoundParameter,
+        TEnumAsByte<EPhysicalSurface>& OutSurfaceType
+    );
+
+    /**
+     * Resolves the surface below an actor from its ground probe, with the same rules as LineTraceForSurfaceTypes.
+     * Reuses the probe's trace of this frame if there was one, so it costs no trace of its own.
+     *
+     * @param GroundProbe The ground probe of the actor
+     * @param SurfaceData Optional data asset containing the map of valid surface types (leave null to use Project Settings)
+     * @param OutMetasoundParameter The Metasound parameter value for the surface (-1 if no valid surface found)
+     * @param OutSurfaceType The surface type that was selected (SurfaceType_Default if none found)
+     * @return True if a valid surface type was found, false otherwise
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Physical Material")
+    static bool GroundProbeForSurfaceTypes(
+        UDemuteGroundProbeComponent* GroundProbe,
+        UAudioSurfaceData* SurfaceData,
+        int32& OutMetasoundParameter,
+        TEnumAsByte<EPhysicalSurface>& OutSurfaceType
+    );
+
+    /**
+     * Stores a finished query in the world's query history for debug drawing, and in the recording if one is open.
+     * LineTraceForSurfaceTypes calls it itself; call it after GetSurfaceTypeFromHit for queries traced another way,
+     * such as asynchronous traces. Does nothing when neither is recording.
+     *
+     * @param QueryingActor Actor the query was made for, recorded by class
+     * @param HitResult The blocking hit of the trace, or null if it missed
+     * @param StartCycles FPlatformTime::Cycles64() when the query started, for its cost
+     */
+    static void RecordSurfaceQuery(
+        UObject* WorldContextObject,
+        const FVector& Start,
+        const FVector& End,
+        ETraceTypeQuery TraceChannel,
+        bool bTraceComplex,
+        const AActor* QueryingActor,
+        const UAudioSurfaceData* SurfaceData,
+        const FHitResult* HitResult,
+        int32 MetasoundParameter,
+        TEnumAsByte<EPhysicalSurface> SurfaceType,
+        uint64 StartCycles
+    );
+
 private:
+
     /**
      * Extracts the physical material from a UMaterialInterface.
      * @param Material The material interface to extract from
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioParameter.h"
+
+class UAudioComponent;
+class UWorld;
+
+/**
+ * Collects the parameter updates of every footstep voice during a frame and submits them together.
+ *
+ * Each UAudioComponent::Set*Parameter call on a playing voice sends its own command to the audio
+ * thread. The batch merges all updates per voice and sends a single audio thread command per
+ * frame for all playing voices. Voices that are not playing yet get their parameters on the game
+ * thread, so they travel with the play command for free.
+ *
+ * Note: updates sent through the batch go straight to the voice. They are not stored on the
+ * component, so a voice restarted after virtualization gets back the parameters it was played with.
+ */
+class DM_SURFACEDETECTOR_API FDemuteAudioParameterBatch
+{
+public:
+    /** Queues a parameter update for a voice. The last value of a parameter in the frame wins. */
+    void Add(UAudioComponent* AudioComponent, FAudioParameter&& Parameter);
+
+    /** Sends all queued updates. Called once per frame by the surface subsystem. */
+    void Flush(UWorld* World);
+
+    /** Drops all queued updates */
+    void Reset();
+
+    /** Number of voices with queued updates */
+    int32 Num() const { return PendingParameters.Num(); }
+
+private:
+    TMap<TWeakObjectPtr<UAudioComponent>, TArray<FAudioParameter>> PendingParameters;
+};
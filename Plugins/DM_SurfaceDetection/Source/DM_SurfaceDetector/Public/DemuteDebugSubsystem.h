@@ -1,8 +1,16 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
 #include "DemuteDebugSubsystem.generated.h"
 
+// Footstep debugging is compiled out of Shipping builds. Define DEMUTE_DEBUG_ENABLED in your
+// Target.cs to force it on or off.
+#ifndef DEMUTE_DEBUG_ENABLED
+#define DEMUTE_DEBUG_ENABLED !UE_BUILD_SHIPPING
+#endif
+
 // Struct to store per-actor debug settings
 USTRUCT(BlueprintType)
 struct FActorDebugSettings
@@ -40,10 +48,21 @@ public:
     UPROPERTY(BlueprintReadWrite, Category = "Footstep Debug")
     bool bPrintMaterialEnabled = false;
 
-    // Per-actor debug settings map
+    // Per-actor debug settings map, by name as registered (for display)
     UPROPERTY(BlueprintReadOnly, Category = "Footstep Debug")
     TMap<FString, FActorDebugSettings> ActorDebugSettings;
 
+    // Cheap check for footstep code: false when no subsystem has any debugging enabled.
+    // Always false when debugging is compiled out.
+    static bool IsAnyDebugEnabled()
+    {
+#if DEMUTE_DEBUG_ENABLED
+        return NumSubsystemsWithDebugEnabled.load(std::memory_order_relaxed) > 0;
+#else
+        return false;
+#endif
+    }
+
     // Toggle logging command
     UFUNCTION(BlueprintCallable, Category = "Footstep Debug")
     void SetFootstepLogging(bool toggle);
@@ -56,10 +75,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Footstep Debug")
     void SetDebugMode(int32 mode);
 
-    // Add actor with specific debug settings
+    // Add actor with specific debug settings (resolved once by name, now or when it spawns)
     UFUNCTION(BlueprintCallable, Category = "Footstep Debug")
     void AddActorDebugSettings(const FString& ActorName, bool bEnablePrint, bool bEnableLogging);
 
+    // Add actor with specific debug settings, without any name lookup
+    UFUNCTION(BlueprintCallable, Category = "Footstep Debug")
+    void AddActorDebugSettingsForActor(AActor* Actor, bool bEnablePrint, bool bEnableLogging);
+
     // Remove actor from settings
     UFUNCTION(BlueprintCallable, Category = "Footstep Debug")
     void RemoveActorDebugSettings(const FString& ActorName);
@@ -91,4 +114,28 @@ public:
     // Subsystem lifecycle
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
+
+private:
+    // Finds the actor with this name in the game world, or waits for it to spawn
+    void ResolveActorName(const FString& ActorName);
+
+    // Resolves pending names against newly spawned actors
+    void OnActorSpawned(AActor* Actor);
+
+    // Keeps the global flag in sync after any settings change
+    void UpdateDebugEnabled();
+
+    // Per-actor settings by object key, the only map looked up per footstep
+    TMap<FObjectKey, FActorDebugSettings> ResolvedActorDebugSettings;
+
+    // Names registered before their actor existed
+    TSet<FString> PendingActorNames;
+
+    FDelegateHandle ActorSpawnedHandle;
+
+    // True while this subsystem counts in NumSubsystemsWithDebugEnabled
+    bool bDebugEnabled = false;
+
+    // Number of game instances (PIE clients) with any debugging enabled
+    static std::atomic<int32> NumSubsystemsWithDebugEnabled;
 };
\ No newline at end of file
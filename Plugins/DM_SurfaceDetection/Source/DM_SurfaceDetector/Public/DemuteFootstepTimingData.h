@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "DemuteFootstepTimingData.generated.h"
+
+class UAnimationAsset;
+
+/** Foot contact of an animation, found by the Audio Animation Tools */
+USTRUCT(BlueprintType)
+struct DM_SURFACEDETECTOR_API FDemuteFootstepContact
+{
+    GENERATED_BODY()
+
+    /** Time of the contact over the play length of the animation (0 to 1) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float Phase = 0.0f;
+
+    /** Foot bone touching the ground */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    FName Foot;
+
+    /** Speed of the foot before the contact, over the speed of the fastest contact of the animation (0 to 1) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float Intensity = 1.0f;
+};
+
+/**
+ * Foot contacts of an animation sequence, precomputed by the Audio Animation Tools (Write Timing Data).
+ *
+ * Stored as asset user data of the sequence: it loads with the sequence and is found from it, without
+ * a lookup table. Runtime systems read the upcoming contacts here instead of scanning the notifies,
+ * e.g. to resolve the surface under the next foot ahead of the contact, or to step characters whose
+ * animation is not evaluated from the time their animation would be at.
+ */
+UCLASS(BlueprintType)
+class DM_SURFACEDETECTOR_API UDemuteFootstepTimingData : public UAssetUserData
+{
+    GENERATED_BODY()
+
+public:
+    /** Play length of the animation when the contacts were generated */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep", meta = (Units = "s"))
+    float PlayLength = 0.0f;
+
+    /** Contacts of all feet, sorted by phase */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Footstep")
+    TArray<FDemuteFootstepContact> Contacts;
+
+    /** Timing data of an animation, null if none was generated */
+    UFUNCTION(BlueprintPure, Category = "Footstep", meta = (DisplayName = "Find Footstep Timing Data"))
+    static UDemuteFootstepTimingData* Find(UAnimationAsset* Animation);
+
+    /**
+     * First contact after Time. Looping animations wrap around to their first contact.
+     * @param Time Current time of the animation, in seconds
+     * @param bLooping Whether the animation loops
+     * @param OutContact The next contact
+     * @param OutTimeToContact Seconds until the contact, at play rate 1
+     * @return False if no contact is left before the end of a non looping animation
+     */
+    UFUNCTION(BlueprintPure, Category = "Footstep")
+    bool GetNextContact(float Time, bool bLooping, FDemuteFootstepContact& OutContact, float& OutTimeToContact) const;
+
+    /**
+     * Contacts after StartTime, up to EndTime included, e.g. between two updates of an animation that is not evaluated.
+     * With bLooping, EndTime may go past the play length, or below StartTime when the animation wrapped around.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Footstep")
+    void GetContactsBetween(float StartTime, float EndTime, bool bLooping, TArray<FDemuteFootstepContact>& OutContacts) const;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
+#include "DemuteGroundProbeComponent.generated.h"
+
+class UPrimitiveComponent;
+
+/** What lies below an actor, as seen by its ground probe */
+USTRUCT(BlueprintType)
+struct DM_SURFACEDETECTOR_API FDemuteGroundHit
+{
+    GENERATED_BODY()
+
+    /** True if the probe found ground within its distance */
+    UPROPERTY(BlueprintReadOnly, Category = "Ground Probe")
+    bool bHit = false;
+
+    /** Distance from the actor location to the ground */
+    UPROPERTY(BlueprintReadOnly, Category = "Ground Probe")
+    float Distance = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Ground Probe")
+    FVector Location = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Ground Probe")
+    FVector Normal = FVector::UpVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Ground Probe")
+    TObjectPtr<UPrimitiveComponent> Component = nullptr;
+
+    /** Surface type of the hit physical material (the component's simple collision material unless the probe traces complex) */
+    UPROPERTY(BlueprintReadOnly, Category = "Ground Probe")
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+
+    /** Full hit, with its physical material, for surface resolution */
+    UPROPERTY(BlueprintReadOnly, Category = "Ground Probe")
+    FHitResult Hit;
+};
+
+/**
+ * Shared downward query of a pawn.
+ *
+ * Camera, gameplay and footsteps all want to know what is below the pawn. The probe traces at most
+ * once per frame, on first request, and every later caller of the frame reads the cached hit.
+ * UDemuteSurfaceSubsystem resolves the footsteps of the owner from it, instead of tracing, when the
+ * request uses the same channel and the foot lands near the probed ground.
+ */
+UCLASS(ClassGroup = (Audio), meta = (BlueprintSpawnableComponent))
+class DM_SURFACEDETECTOR_API UDemuteGroundProbeComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ground Probe")
+    TEnumAsByte<ECollisionChannel> ProbeChannel = ECC_Visibility;
+
+    /** Distance to trace below the actor location */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ground Probe", meta = (ClampMin = "0.0", Units = "cm"))
+    float ProbeDistance = 1000.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ground Probe")
+    bool bTraceComplex = false;
+
+    /** Footsteps landing further than this from the probed ground (horizontally) trace on their own */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ground Probe", meta = (ClampMin = "0.0", Units = "cm"))
+    float FootstepTolerance = 50.0f;
+
+    /** Returns the ground below the owner, tracing if it was not probed yet this frame */
+    const FDemuteGroundHit& GetGround();
+
+    UFUNCTION(BlueprintCallable, Category = "Ground Probe", meta = (DisplayName = "Get Ground"))
+    FDemuteGroundHit K2_GetGround() { return GetGround(); }
+
+    /** Forces the next GetGround to trace again, e.g. after a teleport */
+    UFUNCTION(BlueprintCallable, Category = "Ground Probe")
+    void Invalidate();
+
+    /** True if a footstep trace with these settings would hit the same ground as the probe */
+    bool MatchesTrace(ETraceTypeQuery TraceChannel, bool bComplex) const;
+
+private:
+    void Probe();
+
+    UPROPERTY(Transient)
+    FDemuteGroundHit Ground;
+
+    /** Frame number of the last probe */
+    uint64 ProbeFrame = TNumericLimits<uint64>::Max();
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "DemuteProceduralFootstepComponent.generated.h"
+
+class UAudioSurfaceData;
+class USkeletalMeshComponent;
+class USoundBase;
+
+UENUM(BlueprintType)
+enum class EDemuteProceduralFootstepMode : uint8
+{
+    /** Only steps while the animation cannot be trusted to fire its footstep notifies */
+    WhenNotifiesSkipped,
+    /** Always steps, for characters without footstep notifies */
+    Always,
+};
+
+/**
+ * Step cadence of a character, from its ground speed.
+ * Step length grows linearly from the walk point to the run point.
+ */
+USTRUCT(BlueprintType)
+struct DM_SURFACEDETECTOR_API FDemuteStrideProfile
+{
+    GENERATED_BODY()
+
+    /** Below this speed the character is standing still */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stride", meta = (ClampMin = "0.0", Units = "cm/s"))
+    float MinSpeed = 20.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stride", meta = (ClampMin = "0.0", Units = "cm/s"))
+    float WalkSpeed = 150.0f;
+
+    /** Distance between two footsteps (half a stride) at walk speed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stride", meta = (ClampMin = "1.0", Units = "cm"))
+    float WalkStepLength = 65.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stride", meta = (ClampMin = "0.0", Units = "cm/s"))
+    float RunSpeed = 500.0f;
+
+    /** Distance between two footsteps (half a stride) at run speed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stride", meta = (ClampMin = "1.0", Units = "cm"))
+    float RunStepLength = 130.0f;
+
+    /** Most footsteps per second, whatever the speed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stride", meta = (ClampMin = "0.1"))
+    float MaxCadence = 4.0f;
+
+    /** Distance covered between two footsteps at this speed */
+    float GetStepLength(float Speed) const;
+};
+
+/**
+ * Generates footsteps from movement when animation notifies don't fire.
+ *
+ * With Update Rate Optimisation, or a Visibility Based Anim Tick Option skipping offscreen poses,
+ * distant and offscreen characters stop firing their footstep notifies. This component steps on
+ * a cadence derived from the ground speed and the stride profile, and sends the footsteps through
+ * the voice budget of UDemuteSurfaceSubsystem. Animation can then be throttled without muting the
+ * characters.
+ *
+ * Demute Footstep notifies report to the component, so the procedural cadence resumes in phase
+ * with the last animated footstep.
+ */
+UCLASS(ClassGroup = (Audio), meta = (BlueprintSpawnableComponent))
+class DM_SURFACEDETECTOR_API UDemuteProceduralFootstepComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UDemuteProceduralFootstepComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    EDemuteProceduralFootstepMode Mode = EDemuteProceduralFootstepMode::WhenNotifiesSkipped;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    FDemuteStrideProfile StrideProfile;
+
+    /** Sound to play, usually the MetaSound of the character's footstep notifies */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    TObjectPtr<USoundBase> Metasound;
+
+    /** Optional curated surface map (leave null to use Project Settings surfaces) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    TObjectPtr<UAudioSurfaceData> AudioSurfaceData;
+
+    /** Name of the int parameter receiving the surface value */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    FName SurfaceParameterName = TEXT("Surface");
+
+    /** Name of the float parameter receiving the speed relative to the run speed (0 to 1). Leave empty to not send it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    FName IntensityParameterName;
+
+    /** Foot names of the generated footsteps, shown in the Gameplay Debugger */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    FName LeftFootName = TEXT("foot_l");
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    FName RightFootName = TEXT("foot_r");
+
+    /** Side distance between the two feet. Each trace starts half of it from the actor center. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (ClampMin = "0.0", Units = "cm"))
+    float FootSpacing = 25.0f;
+
+    /** Importance of the footsteps in the voice budget */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (ClampMin = "0.0"))
+    float Significance = 0.5f;
+
+    /** Uses the trace length, channel and complexity of the project settings (Demute Surface Detection) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    bool bUseProjectTraceSettings = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (EditCondition = "!bUseProjectTraceSettings"))
+    TEnumAsByte<ETraceTypeQuery> TraceChannel = TraceTypeQuery1;
+
+    /** Distance to trace below the bottom of the actor's collision */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (ClampMin = "0.0", Units = "cm", EditCondition = "!bUseProjectTraceSettings"))
+    float TraceLength = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (EditCondition = "!bUseProjectTraceSettings"))
+    bool bTraceComplex = false;
+
+    /** Lets the footsteps be merged into a crowd loop when many characters walk nearby */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep|Crowd")
+    bool bAllowCrowdAggregation = false;
+
+    /** Looping MetaSound with a Density parameter (steps per second), played instead of individual footsteps in crowds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep|Crowd", meta = (EditCondition = "bAllowCrowdAggregation"))
+    TObjectPtr<USoundBase> CrowdSound;
+
+    /** URO update rate (frames between two animation updates) above which notifies are too late to trust */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Notifies", meta = (ClampMin = "1", EditCondition = "Mode == EDemuteProceduralFootstepMode::WhenNotifiesSkipped"))
+    int32 MaxNotifyUpdateRate = 2;
+
+    /**
+     * Steps procedurally when the character moves without a Demute Footstep notify for this long,
+     * once it has received one. Covers animations throttled by other means. 0 disables it.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Notifies", meta = (ClampMin = "0.0", Units = "s", EditCondition = "Mode == EDemuteProceduralFootstepMode::WhenNotifiesSkipped"))
+    float NotifyTimeout = 1.0f;
+
+    /**
+     * Called by Demute Footstep notifies. Resets the procedural cadence to this footstep, and steps with the other foot next.
+     * Returns false if the component is generating the footsteps, in which case the notify should not play.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Footstep")
+    bool NotifyAnimFootstep(FName Foot);
+
+    /** True while the component generates the character's footsteps */
+    UFUNCTION(BlueprintPure, Category = "Footstep")
+    bool IsGeneratingFootsteps() const;
+
+    virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+    /** True if the skeletal mesh currently skips or delays its notifies */
+    bool AreNotifiesSkipped() const;
+
+    /** Submits a footstep of the next foot, at ContactTime */
+    void RequestStep(float Speed, double ContactTime);
+
+    /** Mesh playing the footstep notifies, found on the owner at BeginPlay */
+    UPROPERTY(Transient)
+    TObjectPtr<USkeletalMeshComponent> Mesh;
+
+    /** Ground distance covered since the last footstep */
+    float StepDistance = 0.0f;
+
+    /** World time of the last Demute Footstep notify, negative if none was received */
+    double LastNotifyTime = -1.0;
+
+    /** World time the character last started moving, so standing still doesn't count towards NotifyTimeout */
+    double MoveStartTime = 0.0;
+
+    bool bMoving = false;
+
+    bool bLeftFootNext = true;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "DemuteDebugSubsystem.h"
+
+class UWorld;
+
+/** One surface query, as recorded for debug drawing */
+struct FDemuteSurfaceQueryRecord
+{
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    FVector HitLocation = FVector::ZeroVector;
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+    bool bHit = false;
+    bool bFoundSurface = false;
+    float CostMicroseconds = 0.0f;
+};
+
+/**
+ * Ring buffer of the last surface queries of a world, drawn as a single batch of lines each frame.
+ *
+ * Controlled by DEMUTE.Debug.DrawSurfaceQueries:
+ *   0 = off, nothing is recorded
+ *   1 = colour by surface type (red = miss, grey = hit without a valid surface)
+ *   2 = colour by cost, green to red up to DEMUTE.Debug.SurfaceQueryMaxCost microseconds
+ */
+class DM_SURFACEDETECTOR_API FDemuteSurfaceQueryHistory
+{
+public:
+    /** True when queries should be recorded. Always false when debugging is compiled out. */
+    static bool IsRecording();
+
+    /** Stores a query, overwriting the oldest one once the buffer is full */
+    void Add(const FDemuteSurfaceQueryRecord& Record);
+
+    /** Submits every recorded query to the world line batcher in one call */
+    void Draw(UWorld* World) const;
+
+    void Reset();
+
+    int32 Num() const { return Records.Num(); }
+
+private:
+    TArray<FDemuteSurfaceQueryRecord> Records;
+
+    /** Index of the oldest record once the buffer is full */
+    int32 NextIndex = 0;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/ObjectKey.h"
+#include "DemuteDebugSubsystem.h"
+
+/** One surface query as stored in a recording */
+struct FDemuteRecordedSurfaceQuery
+{
+    /** World time of the query, in seconds */
+    double Time = 0.0;
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    TEnumAsByte<ETraceTypeQuery> TraceChannel = TraceTypeQuery1;
+    bool bTraceComplex = false;
+
+    /** Class path of the querying actor (first ignored actor), empty if none */
+    FString ActorClass;
+
+    /** Path of the surface data asset used, empty in fallback mode */
+    FString SurfaceData;
+
+    bool bHit = false;
+    bool bFoundSurface = false;
+    int32 MetasoundParameter = -1;
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+};
+
+/**
+ * Writes every surface query of a play session to a compact binary file, for offline replay with
+ * the DemuteSurfaceQueryReplay commandlet.
+ *
+ * Controlled by DEMUTE.Record.Start [File] and DEMUTE.Record.Stop. Records are streamed as they
+ * happen; class and asset paths are written once and referenced by index afterwards.
+ */
+class DM_SURFACEDETECTOR_API FDemuteSurfaceQueryRecorder
+{
+public:
+    static FDemuteSurfaceQueryRecorder& Get();
+
+    /** Opens the file and writes the header. MapName is the level to load when replaying. */
+    bool Start(const FString& Filename, const FString& MapName);
+
+    void Stop();
+
+    /** True while a recording is open. Always false when debugging is compiled out. */
+    static bool IsRecording()
+    {
+#if DEMUTE_DEBUG_ENABLED
+        return bIsRecording;
+#else
+        return false;
+#endif
+    }
+
+    void Record(double Time, const FVector& Start, const FVector& End, ETraceTypeQuery TraceChannel, bool bTraceComplex,
+        const UObject* ActorClass, const UObject* SurfaceData, bool bHit, bool bFoundSurface, int32 MetasoundParameter,
+        TEnumAsByte<EPhysicalSurface> SurfaceType);
+
+    int32 GetNumRecorded() const { return NumRecorded; }
+
+    /** Reads a whole recording. Returns false if the file is missing or not a recording. */
+    static bool LoadFile(const FString& Filename, FString& OutMapName, TArray<FDemuteRecordedSurfaceQuery>& OutQueries);
+
+private:
+    /** Writes the path table index of an object, and its path the first time it is seen */
+    void WritePath(const UObject* Object);
+
+    TUniquePtr<FArchive> Writer;
+
+    /** Path table index of each object written so far */
+    TMap<FObjectKey, uint32> PathIndices;
+
+    int32 NumRecorded = 0;
+
+    static bool bIsRecording;
+};
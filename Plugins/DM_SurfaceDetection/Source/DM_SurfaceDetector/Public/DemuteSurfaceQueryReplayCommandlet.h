@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DemuteSurfaceQueryReplayCommandlet.generated.h"
+
+class UAudioSurfaceData;
+class UWorld;
+
+/**
+ * Replays a surface query recording (see DEMUTE.Record.Start) against its level, headless, and
+ * reports query timings and every result that differs from the recording.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=DemuteSurfaceQueryReplay -Recording=<File> [options]
+ *
+ * Options:
+ *   -Map=<Package>          Level to load instead of the recorded one
+ *   -SurfaceData=<Path>     Surface data asset used for every query instead of the recorded ones
+ *   -FallbackMode           Replay every query without surface data (Project Settings surfaces)
+ *   -Complex=<0|1>          Force simple or complex traces
+ *   -Iterations=<N>         Replay the stream N times, timings are averaged (default 1)
+ *   -MaxDiffs=<N>           Number of differing queries logged in detail (default 20)
+ *   -FailOnDiff             Return an error code when any result differs, for regression checks
+ */
+UCLASS()
+class DM_SURFACEDETECTOR_API UDemuteSurfaceQueryReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UDemuteSurfaceQueryReplayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Loads the level and registers its components so traces can hit them */
+    UWorld* LoadWorld(const FString& MapName) const;
+
+    /** Recorded surface data paths loaded once */
+    UAudioSurfaceData* FindSurfaceData(const FString& Path);
+
+    UPROPERTY(Transient)
+    TMap<FString, TObjectPtr<UAudioSurfaceData>> LoadedSurfaceData;
+};
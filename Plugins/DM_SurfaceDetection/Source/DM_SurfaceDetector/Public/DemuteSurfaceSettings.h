@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Engine/EngineTypes.h"
+#include "DemuteSurfaceSettings.generated.h"
+
+/** How the footstep subsystem resolves the surface of an admitted footstep */
+UENUM(BlueprintType)
+enum class EDemuteSurfaceResolvePreference : uint8
+{
+    /** Trace every footstep */
+    AlwaysTrace,
+
+    /** Reuse the actor's cached surface while it is fresh and nearby, trace otherwise */
+    PreferCache,
+};
+
+/** Performance tuning of surface detection, for the whole project or one platform */
+USTRUCT(BlueprintType)
+struct DM_SURFACEDETECTOR_API FDemuteSurfacePerformancePolicy
+{
+    GENERATED_BODY()
+
+    /** Trace length below the foot used by notifies that keep the project trace settings */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trace", meta = (ClampMin = "0.0", Units = "cm"))
+    float TraceLength = 100.0f;
+
+    /** Trace channel used by notifies that keep the project trace settings */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trace")
+    TEnumAsByte<ETraceTypeQuery> TraceChannel = TraceTypeQuery1;
+
+    /** Complex traces read the hit physical material directly but cost more */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trace")
+    bool bTraceComplex = false;
+
+    /** Runs footstep traces asynchronously: the voice starts one frame later, the trace leaves the game thread */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trace")
+    bool bUseAsyncTraces = false;
+
+    /** Starts footstep voices on a Quartz clock at contact time plus a fixed latency, independent of the game frame */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Scheduling")
+    bool bScheduleWithQuartz = false;
+
+    /** Constant delay between contact and voice start when scheduling with Quartz */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Scheduling", meta = (ClampMin = "0.0", Units = "s", EditCondition = "bScheduleWithQuartz"))
+    float QuartzScheduleLatency = 0.05f;
+
+    /** Trace every footstep, or reuse the last surface of an actor when possible */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trace")
+    EDemuteSurfaceResolvePreference ResolvePreference = EDemuteSurfaceResolvePreference::AlwaysTrace;
+
+    /** Queries the surface of the next footstep of the animation before its contact, so the footstep plays without tracing */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Prediction")
+    bool bPredictFootsteps = true;
+
+    /** How long before the predicted contact its async query is issued */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Prediction", meta = (ClampMin = "0.0", Units = "s", EditCondition = "bPredictFootsteps"))
+    float PredictionLeadTime = 0.1f;
+
+    /** Maximum horizontal distance between the predicted and actual foot positions for the prediction to be used */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Prediction", meta = (ClampMin = "0.0", Units = "cm", EditCondition = "bPredictFootsteps"))
+    float PredictionTolerance = 30.0f;
+
+    /** Maximum number of prediction queries issued per frame */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Prediction", meta = (ClampMin = "0", EditCondition = "bPredictFootsteps"))
+    int32 MaxPredictionTracesPerFrame = 8;
+
+    /** Maximum number of footsteps traced and voiced per frame */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Budget", meta = (ClampMin = "0"))
+    int32 MaxFootstepsPerFrame = 8;
+
+    /** Maximum number of footstep voices playing at the same time */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Budget", meta = (ClampMin = "0"))
+    int32 MaxActiveFootstepVoices = 24;
+
+    /** Maximum number of traces per frame refreshing the cached surface of crowd agents */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Budget", meta = (ClampMin = "0"))
+    int32 MaxCrowdRefreshTracesPerFrame = 4;
+
+    /** Footsteps closer than this to the listener all rank at full priority (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance", meta = (ClampMin = "0.0", Units = "cm"))
+    float FullPriorityDistance = 0.0f;
+
+    /** Requests further than this from the listener are rejected, for sounds without attenuation (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance", meta = (ClampMin = "0.0", Units = "cm"))
+    float MaxAudibleDistance = 5000.0f;
+
+    /** Maximum number of actors remembered by the surface cache. The least recently traced are forgotten first. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Cache", meta = (ClampMin = "1"))
+    int32 MaxCachedActors = 512;
+
+    /** How long the cached surface of an actor is trusted before tracing again */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Cache", meta = (ClampMin = "0.0", Units = "s"))
+    float SurfaceCacheLifetime = 2.0f;
+
+    /** How far an actor can move from where its surface was traced before it is traced again */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Cache", meta = (ClampMin = "0.0", Units = "cm"))
+    float SurfaceCacheRadius = 400.0f;
+};
+
+/**
+ * Project settings of the surface detection plugin (Project Settings > Plugins > Demute Surface Detection).
+ *
+ * The default policy applies everywhere; platform overrides replace it entirely on their platform.
+ * Stored in DefaultGame.ini, so platforms can also be tuned from their own Game.ini.
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Demute Surface Detection"))
+class DM_SURFACEDETECTOR_API UDemuteSurfaceSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    UDemuteSurfaceSettings();
+
+    /** Policy used on platforms without an override */
+    UPROPERTY(config, EditAnywhere, Category = "Performance")
+    FDemuteSurfacePerformancePolicy DefaultPolicy;
+
+    /** Policies by ini platform name (Windows, Linux, Android, ...) */
+    UPROPERTY(config, EditAnywhere, Category = "Performance")
+    TMap<FString, FDemuteSurfacePerformancePolicy> PlatformOverrides;
+
+    /** Policy of the platform the game is running on */
+    const FDemuteSurfacePerformancePolicy& GetPolicy() const;
+
+    static const UDemuteSurfaceSettings* Get() { return GetDefault<UDemuteSurfaceSettings>(); }
+};
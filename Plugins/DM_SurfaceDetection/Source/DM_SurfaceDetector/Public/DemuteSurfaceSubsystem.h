@@ -0,0 +1,493 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "AudioSurfaceData.h"
+#include "DemuteAudioParameterBatch.h"
+#include "DemuteSurfaceQueryHistory.h"
+#include "DemuteSurfaceSettings.h"
+#include "DemuteSurfaceSubsystem.generated.h"
+
+class UAudioComponent;
+class UAnimSequenceBase;
+class UQuartzClockHandle;
+class USkeletalMeshComponent;
+class USoundBase;
+
+/**
+ * A surface-dependent footstep waiting for the voice budget.
+ * Filled by UAnimNotify_DemuteFootstep, or by hand from Blueprint for custom triggers.
+ */
+USTRUCT(BlueprintType)
+struct DM_SURFACEDETECTOR_API FDemuteFootstepRequest
+{
+    GENERATED_BODY()
+
+    /** Actor making the footstep. Ignored by the trace, and used to remember its last surface. */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    TObjectPtr<AActor> Instigator = nullptr;
+
+    /** Foot making the step (usually the socket name), shown per foot in the Gameplay Debugger */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    FName Foot;
+
+    /** Start location of the surface trace (usually the foot socket) */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    FVector Start = FVector::ZeroVector;
+
+    /** End location of the surface trace */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    FVector End = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    TEnumAsByte<ETraceTypeQuery> TraceChannel = TraceTypeQuery1;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    bool bTraceComplex = false;
+
+    /** Optional curated surface map (see LineTraceForSurfaceTypes) */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    TObjectPtr<UAudioSurfaceData> SurfaceData = nullptr;
+
+    /** Sound to play, usually a MetaSound reading the surface parameter */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    TObjectPtr<USoundBase> Sound = nullptr;
+
+    /** Name of the int parameter receiving the surface value */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    FName SurfaceParameterName = TEXT("Surface");
+
+    /** Strength of the footstep (e.g. derived from the foot speed), sent if IntensityParameterName is set */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    float Intensity = 1.0f;
+
+    /** Name of the float parameter receiving the intensity. Leave empty to not send it. */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request")
+    FName IntensityParameterName;
+
+    /** Gameplay importance of the instigator (e.g. 1 for the player, lower for background NPCs) */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request", meta = (ClampMin = "0.0"))
+    float Significance = 1.0f;
+
+    /** Lets this footstep be merged into a crowd loop when many characters walk nearby */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request|Crowd")
+    bool bAllowCrowdAggregation = false;
+
+    /** Looping sound driven by the crowd density parameter, played when the footstep is aggregated */
+    UPROPERTY(BlueprintReadWrite, Category = "Footstep Request|Crowd")
+    TObjectPtr<USoundBase> CrowdSound = nullptr;
+
+    /** Rank of the request in the budget, computed on submission. Higher plays first. */
+    float Priority = 0.0f;
+
+    /** World time the foot touched the ground: the predicted contact if known, else the submission time */
+    double ContactTime = 0.0;
+};
+
+/**
+ * Surface cache entry: what the subsystem remembers about an actor between two footsteps.
+ * Used to rank requests before tracing, and to cluster crowds without tracing every step.
+ */
+struct FDemuteActorSurfaceState
+{
+    TEnumAsByte<EPhysicalSurface> LastSurfaceType = SurfaceType_Default;
+    int32 LastMetasoundParameter = -1;
+    FVector LastLocation = FVector::ZeroVector;
+    double LastTime = 0.0;
+};
+
+/** Surface queried ahead of an expected footstep, consumed by the footstep when it lands close enough */
+struct FDemuteFootstepPrediction
+{
+    TWeakObjectPtr<USkeletalMeshComponent> MeshComponent;
+    TWeakObjectPtr<UAudioSurfaceData> SurfaceData;
+    FName SocketName;
+    float TraceLength = 0.0f;
+    TEnumAsByte<ETraceTypeQuery> TraceChannel = TraceTypeQuery1;
+    bool bTraceComplex = false;
+
+    /** World times at which the query is issued, and at which the foot is expected to land */
+    double IssueTime = 0.0;
+    double ContactTime = 0.0;
+
+    FVector PredictedLocation = FVector::ZeroVector;
+    bool bIssued = false;
+    bool bDone = false;
+    bool bFoundSurface = false;
+    int32 MetasoundParameter = -1;
+};
+
+/** Last footstep notify of a mesh, to measure the play rate of its animation from one footstep to the next */
+struct FDemuteFootstepPhase
+{
+    TObjectKey<UAnimSequenceBase> Animation;
+    float AnimationTime = 0.0f;
+    double WorldTime = 0.0;
+};
+
+/** Per-actor footstep counters for the DemuteFootsteps Gameplay Debugger category. Not collected in Shipping. */
+struct FDemuteFootstepStats
+{
+    /** Last surface resolved for each foot */
+    TArray<TPair<FName, TEnumAsByte<EPhysicalSurface>>, TInlineAllocator<2>> LastSurfacePerFoot;
+
+    int32 RequestCount = 0;
+
+    /** Surface traces actually run */
+    int32 QueryCount = 0;
+
+    /** Crowd steps that reused the cached surface instead of tracing */
+    int32 CacheHitCount = 0;
+
+    /** Footsteps that played with a surface queried ahead of contact */
+    int32 PredictionHitCount = 0;
+
+    /** Rejected on submission as out of hearing range */
+    int32 CulledCount = 0;
+
+    /** Over the frame, voice or crowd refresh budget */
+    int32 DroppedCount = 0;
+
+    /** Counted into a crowd loop instead of getting a voice */
+    int32 AggregatedCount = 0;
+
+    double TotalQuerySeconds = 0.0;
+    double FirstRequestTime = 0.0;
+    float LastSignificance = 0.0f;
+    float LastPriority = 0.0f;
+};
+
+/** Crowd clusters group footsteps by grid cell, surface and crowd loop */
+struct FDemuteCrowdClusterKey
+{
+    FIntVector Cell = FIntVector::ZeroValue;
+    int32 MetasoundParameter = -1;
+    TObjectKey<USoundBase> CrowdSound;
+
+    bool operator==(const FDemuteCrowdClusterKey& Other) const
+    {
+        return Cell == Other.Cell && MetasoundParameter == Other.MetasoundParameter && CrowdSound == Other.CrowdSound;
+    }
+
+    friend uint32 GetTypeHash(const FDemuteCrowdClusterKey& Key)
+    {
+        return HashCombine(HashCombine(GetTypeHash(Key.Cell), GetTypeHash(Key.MetasoundParameter)), GetTypeHash(Key.CrowdSound));
+    }
+};
+
+/** One looping crowd voice, and the steps counted for it during the current window */
+struct FDemuteCrowdCluster
+{
+    TWeakObjectPtr<UAudioComponent> LoopComponent;
+    TWeakObjectPtr<USoundBase> CrowdSound;
+    FName SurfaceParameterName;
+    FVector LocationSum = FVector::ZeroVector;
+    int32 StepCount = 0;
+    int32 IdleWindows = 0;
+};
+
+/** Agents seen in a grid cell, deciding whether footsteps there are aggregated */
+struct FDemuteCrowdCell
+{
+    TSet<TObjectKey<AActor>> CurrentAgents;
+    int32 PreviousAgentCount = 0;
+};
+
+/**
+ * World subsystem owning the footstep voice budget.
+ *
+ * Footstep requests are not traced when submitted. They are ranked by listener distance,
+ * instigator significance and the loudness of the last surface the instigator walked on,
+ * then at the end of the frame only the best MaxFootstepsPerFrame are traced and voiced.
+ * Inaudible requests are rejected on submission, and culled requests never trace or create a
+ * voice, so they cost almost nothing when 50 enemies spawn and step in the same frame.
+ *
+ * Requests allowing crowd aggregation are grouped on a grid. When enough agents walk in the same
+ * cell, their steps are counted per surface (read from the surface cache) instead of being voiced,
+ * and each cluster drives a single looping crowd sound with a steps-per-second density parameter.
+ */
+UCLASS()
+class DM_SURFACEDETECTOR_API UDemuteSurfaceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Maximum number of footsteps traced and voiced per frame. Lower priority requests are culled. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Budget", meta = (ClampMin = "0"))
+    int32 MaxFootstepsPerFrame = 8;
+
+    /** Maximum number of footstep voices playing at the same time */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Budget", meta = (ClampMin = "0"))
+    int32 MaxActiveFootstepVoices = 24;
+
+    /** Requests further than this from the listener are rejected, for sounds without attenuation (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Budget", meta = (ClampMin = "0.0", Units = "cm"))
+    float MaxAudibleDistance = 5000.0f;
+
+    /** Requests closer than this to the listener all rank at full priority (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Budget", meta = (ClampMin = "0.0", Units = "cm"))
+    float FullPriorityDistance = 0.0f;
+
+    /** Trace every admitted footstep, or reuse the instigator's cached surface when possible */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution")
+    EDemuteSurfaceResolvePreference ResolvePreference = EDemuteSurfaceResolvePreference::AlwaysTrace;
+
+    /** Traces admitted footsteps asynchronously; their voices start when the trace completes, usually next frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution")
+    bool bUseAsyncTraces = false;
+
+    /** Queries the surface of the next footstep before its contact (see PredictFootstep) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution|Prediction")
+    bool bPredictFootsteps = true;
+
+    /** How long before the predicted contact its async query is issued */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution|Prediction", meta = (ClampMin = "0.0", Units = "s"))
+    float PredictionLeadTime = 0.1f;
+
+    /** Maximum horizontal distance between the predicted and actual foot positions for the prediction to be used */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution|Prediction", meta = (ClampMin = "0.0", Units = "cm"))
+    float PredictionTolerance = 30.0f;
+
+    /** Maximum number of prediction queries issued per frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution|Prediction", meta = (ClampMin = "0"))
+    int32 MaxPredictionTracesPerFrame = 8;
+
+    /** Starts footstep voices on a Quartz clock at their contact time plus QuartzScheduleLatency, instead of on the next game frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution|Scheduling")
+    bool bScheduleWithQuartz = false;
+
+    /** Constant delay between contact and voice start. Hides frame and trace latency shorter than it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution|Scheduling", meta = (ClampMin = "0.0", Units = "s"))
+    float QuartzScheduleLatency = 0.05f;
+
+    /** Maximum number of actors in the surface cache. The least recently traced are forgotten first. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution", meta = (ClampMin = "1"))
+    int32 MaxCachedActors = 512;
+
+    /** How long the cached surface of an actor is trusted before tracing again */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution", meta = (ClampMin = "0.0", Units = "s"))
+    float SurfaceCacheLifetime = 2.0f;
+
+    /** How far an actor can move from where its surface was traced before it is traced again */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Resolution", meta = (ClampMin = "0.0", Units = "cm"))
+    float SurfaceCacheRadius = 400.0f;
+
+    /** Merges crowd footsteps into density-driven loops */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd Aggregation")
+    bool bEnableCrowdAggregation = true;
+
+    /** Size of the grid cells used to cluster crowds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd Aggregation", meta = (ClampMin = "100.0", Units = "cm"))
+    float CrowdCellSize = 800.0f;
+
+    /** Number of different agents stepping in a cell during a window before their steps are aggregated */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd Aggregation", meta = (ClampMin = "1"))
+    int32 CrowdMinAgents = 6;
+
+    /** Duration of the step counting window. The density parameter is updated once per window. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd Aggregation", meta = (ClampMin = "0.05", Units = "s"))
+    float CrowdWindow = 0.5f;
+
+    /** Maximum number of traces per frame refreshing the cached surface of crowd agents */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd Aggregation", meta = (ClampMin = "0"))
+    int32 MaxCrowdRefreshTracesPerFrame = 4;
+
+    /** Float parameter of the crowd loop receiving the steps per second of its cluster */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd Aggregation")
+    FName CrowdDensityParameterName = TEXT("Density");
+
+    /** Copies a performance policy into the budget and surface resolution settings. Called with the project settings on Initialize. */
+    UFUNCTION(BlueprintCallable, Category = "Footstep Budget")
+    void ApplyPolicy(const FDemuteSurfacePerformancePolicy& Policy);
+
+    /**
+     * Submits a footstep to the voice budget.
+     * @param Request The footstep to trace and play
+     * @return True if the request was queued, false if it was rejected (inaudible or invalid)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Footstep Budget")
+    bool RequestFootstep(const FDemuteFootstepRequest& Request);
+
+    /**
+     * Schedules an async surface query for a footstep expected in TimeToContact seconds, issued
+     * PredictionLeadTime before contact at the foot position extrapolated from the owner velocity.
+     * The footstep request from that foot then uses the result instead of tracing.
+     * Sound is the footstep's sound, skipped like RequestFootstep when it cannot be heard.
+     */
+    void PredictFootstep(USkeletalMeshComponent* MeshComponent, FName SocketName, float TraceLength, ETraceTypeQuery TraceChannel,
+        bool bTraceComplex, UAudioSurfaceData* SurfaceData, const USoundBase* Sound, float TimeToContact);
+
+    /**
+     * Play rate of the animation firing a mesh's footstep notifies, measured from the animation and world time elapsed
+     * since its previous footstep. Works whatever plays the animation (sequence player, blend space, montage).
+     * @return The play rate, or 0 when unknown: first footstep, a different animation than the previous one, or a long pause
+     */
+    float MeasureFootstepPlayRate(const USkeletalMeshComponent* MeshComponent, const UAnimSequenceBase* Animation, float AnimationTime);
+
+    /** Number of requests rejected or culled since the subsystem started */
+    UFUNCTION(BlueprintPure, Category = "Footstep Budget")
+    int32 GetCulledFootstepCount() const { return CulledFootstepCount; }
+
+    /** Number of footstep voices currently playing */
+    UFUNCTION(BlueprintPure, Category = "Footstep Budget")
+    int32 GetActiveFootstepVoiceCount() const { return ActiveVoices.Num(); }
+
+    /** Queues a float parameter update for a footstep voice, sent with all other updates at the end of the frame */
+    UFUNCTION(BlueprintCallable, Category = "Footstep Budget|Parameters")
+    void SetVoiceFloatParameter(UAudioComponent* Voice, FName ParameterName, float Value);
+
+    /** Queues an int parameter update for a footstep voice, sent with all other updates at the end of the frame */
+    UFUNCTION(BlueprintCallable, Category = "Footstep Budget|Parameters")
+    void SetVoiceIntParameter(UAudioComponent* Voice, FName ParameterName, int32 Value);
+
+    /** Queues a trigger for a footstep voice, sent with all other updates at the end of the frame */
+    UFUNCTION(BlueprintCallable, Category = "Footstep Budget|Parameters")
+    void SetVoiceTriggerParameter(UAudioComponent* Voice, FName ParameterName);
+
+    /** Parameter updates of all footstep voices for this frame, flushed at the end of Tick */
+    FDemuteAudioParameterBatch& GetParameterBatch() { return ParameterBatch; }
+
+    /** Recent surface queries of this world, drawn when DEMUTE.Debug.DrawSurfaceQueries is on */
+    FDemuteSurfaceQueryHistory& GetQueryHistory() { return QueryHistory; }
+
+    /** Footstep counters of an actor, or null if it made no footstep while they were collected (always null in Shipping) */
+    const FDemuteFootstepStats* GetFootstepStats(const AActor* Actor) const { return FootstepStats.Find(Actor); }
+
+    /** Collects footstep counters for a couple of seconds. Called every frame by the Gameplay Debugger category showing them. */
+    void KeepFootstepStats() { FootstepStatsRequestTime = FPlatformTime::Seconds(); }
+
+    /** Number of crowd loops currently playing */
+    UFUNCTION(BlueprintPure, Category = "Crowd Aggregation")
+    int32 GetCrowdClusterCount() const { return CrowdClusters.Num(); }
+
+    // Subsystem lifecycle
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual bool IsTickableInEditor() const override { return true; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Ranks the pending requests and processes the ones fitting in the budget */
+    void ProcessPendingRequests();
+
+    /** Resolves the surface and plays the voice of an admitted request */
+    void ProcessRequest(FDemuteFootstepRequest& Request);
+
+    /** Traces the surface of a request and stores it in the surface cache */
+    bool ResolveSurface(const FDemuteFootstepRequest& Request, int32& OutMetasoundParameter, TEnumAsByte<EPhysicalSurface>& OutSurfaceType);
+
+    /** Resolves the surface from the instigator's ground probe, if it has one matching the request */
+    bool GetProbedSurface(const FDemuteFootstepRequest& Request, int32& OutMetasoundParameter);
+
+    /** Starts the surface trace of a request off the game thread; OnAsyncTraceDone plays its voice */
+    void StartAsyncTrace(const FDemuteFootstepRequest& Request);
+
+    void OnAsyncTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+    /** Updates the surface cache, stats and debug output with a resolved surface */
+    void OnSurfaceResolved(const FDemuteFootstepRequest& Request, bool bFoundSurface, int32 MetasoundParameter, TEnumAsByte<EPhysicalSurface> SurfaceType, double QuerySeconds);
+
+    void StartFootstepVoice(const FDemuteFootstepRequest& Request, int32 MetasoundParameter);
+
+    /** Issues the async queries of the predictions due this frame and forgets the stale ones */
+    void IssueDuePredictions();
+
+    void OnPredictionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+    /** Takes the predicted surface of the request's foot if it matches where the foot landed */
+    bool ConsumePrediction(FDemuteFootstepRequest& Request, int32& OutMetasoundParameter);
+
+    /** Returns the cached surface of the instigator if it is still trusted for this request */
+    bool GetCachedSurface(const FDemuteFootstepRequest& Request, int32& OutMetasoundParameter) const;
+
+    /** Counts crowd footsteps into clusters, or forwards them to the budget when the cell is not crowded */
+    void ProcessCrowdRequests();
+
+    /** Pushes the density of the last window to the crowd loops, starting and stopping them as needed */
+    void UpdateCrowdClusters(float WindowDuration);
+
+    void StopCrowdLoops();
+
+    /** Creates and plays the footstep voice with its surface parameter */
+    UAudioComponent* PlayFootstepVoice(const FDemuteFootstepRequest& Request, int32 MetasoundParameter);
+
+    /** Clock scheduling footstep voices, created on first use */
+    UQuartzClockHandle* GetFootstepClock();
+
+    /** Distance above which a request for this sound cannot be heard */
+    float GetAudibleDistance(const USoundBase* Sound) const;
+
+    /** Location of the first local listener, false if there is none */
+    bool GetListenerLocation(FVector& OutLocation) const;
+
+    /** Removes the voices that finished playing */
+    void PruneFinishedVoices();
+
+    /** Counters of the instigator, or null when there is none, nobody looks at them or debugging is compiled out */
+    FDemuteFootstepStats* FindOrAddFootstepStats(const AActor* Actor);
+
+    /** Requests submitted this frame, processed in Tick */
+    UPROPERTY(Transient)
+    TArray<FDemuteFootstepRequest> PendingRequests;
+
+    /** Crowd-enabled requests submitted this frame, processed in Tick before the budget */
+    UPROPERTY(Transient)
+    TArray<FDemuteFootstepRequest> PendingCrowdRequests;
+
+    /** Requests waiting for their async trace, by trace user data */
+    UPROPERTY(Transient)
+    TMap<uint32, FDemuteFootstepRequest> AsyncRequests;
+
+    FTraceDelegate AsyncTraceDelegate;
+
+    uint32 NextAsyncRequestId = 0;
+
+    /** Scheduled and completed footstep predictions, by trace user data */
+    TMap<uint32, FDemuteFootstepPrediction> Predictions;
+
+    FTraceDelegate PredictionTraceDelegate;
+
+    uint32 NextPredictionId = 0;
+
+    /** Last footstep notify of each mesh, for MeasureFootstepPlayRate */
+    TMap<TObjectKey<USkeletalMeshComponent>, FDemuteFootstepPhase> FootstepPhases;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UQuartzClockHandle> FootstepClock;
+
+    /** Keeps the crowd loops alive; clusters only hold weak references */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UAudioComponent>> CrowdLoopComponents;
+
+    /** Footstep voices still playing. Components auto-destroy, so only weak references are kept. */
+    TArray<TWeakObjectPtr<UAudioComponent>> ActiveVoices;
+
+    /** Last surface of each actor, used to estimate the loudness of its next step before tracing */
+    TMap<TObjectKey<AActor>, FDemuteActorSurfaceState> ActorSurfaceStates;
+
+    TMap<TObjectKey<AActor>, FDemuteFootstepStats> FootstepStats;
+
+    /** Last time the Gameplay Debugger asked for the footstep counters */
+    double FootstepStatsRequestTime = -UE_BIG_NUMBER;
+
+    TMap<FDemuteCrowdClusterKey, FDemuteCrowdCluster> CrowdClusters;
+
+    TMap<FIntVector, FDemuteCrowdCell> CrowdCells;
+
+    FDemuteAudioParameterBatch ParameterBatch;
+
+    FDemuteSurfaceQueryHistory QueryHistory;
+
+    float CrowdWindowElapsed = 0.0f;
+
+    int32 CulledFootstepCount = 0;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimationAsset.h"
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "DemuteSyncMarkerFootstepComponent.generated.h"
+
+class UAudioSurfaceData;
+class USkeletalMeshComponent;
+class USoundBase;
+
+/**
+ * Plays footsteps from the foot contact sync markers of a sync group, instead of footstep notifies.
+ *
+ * Notifies fire from every asset of a blend: blended locomotion plays duplicate footsteps, or misses
+ * some when the weights are low. Sync markers are followed by the leader of the sync group only, so
+ * the component steps once per marker passed whatever the number of blended assets, including
+ * several markers passed in one tick. Generate the markers
+ * with the Audio Animation Tools (Write Sync Markers).
+ */
+UCLASS(ClassGroup = (Audio), meta = (BlueprintSpawnableComponent))
+class DM_SURFACEDETECTOR_API UDemuteSyncMarkerFootstepComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UDemuteSyncMarkerFootstepComponent();
+
+    /** Sync group of the locomotion, as set on the sequence players and blend spaces of the Anim Blueprint */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    FName SyncGroupName = TEXT("Locomotion");
+
+    /** Foot bone or socket of each contact marker. Markers missing from the map are not footsteps. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    TMap<FName, FName> MarkerFeet = { { TEXT("L"), TEXT("foot_l") }, { TEXT("R"), TEXT("foot_r") } };
+
+    /** Sound to play, usually the MetaSound of the character's footstep notifies */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    TObjectPtr<USoundBase> Metasound;
+
+    /** Optional curated surface map (leave null to use Project Settings surfaces) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    TObjectPtr<UAudioSurfaceData> AudioSurfaceData;
+
+    /** Name of the int parameter receiving the surface value */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    FName SurfaceParameterName = TEXT("Surface");
+
+    /** Importance of the footsteps in the voice budget */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (ClampMin = "0.0"))
+    float Significance = 1.0f;
+
+    /** Uses the trace length, channel and complexity of the project settings (Demute Surface Detection) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep")
+    bool bUseProjectTraceSettings = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (EditCondition = "!bUseProjectTraceSettings"))
+    TEnumAsByte<ETraceTypeQuery> TraceChannel = TraceTypeQuery1;
+
+    /** Distance to trace below the foot */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (ClampMin = "0.0", Units = "cm", EditCondition = "!bUseProjectTraceSettings"))
+    float TraceLength = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep", meta = (EditCondition = "!bUseProjectTraceSettings"))
+    bool bTraceComplex = false;
+
+    /** Lets the footsteps be merged into a crowd loop when many characters walk nearby */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep|Crowd")
+    bool bAllowCrowdAggregation = false;
+
+    /** Looping MetaSound with a Density parameter (steps per second), played instead of individual footsteps in crowds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep|Crowd", meta = (EditCondition = "bAllowCrowdAggregation"))
+    TObjectPtr<USoundBase> CrowdSound;
+
+    virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+    /** Submits a footstep of the foot of Marker */
+    void RequestStep(FName Marker);
+
+    /** Submits the footsteps of the markers passed since the previous tick, up to the current position, in the direction of play */
+    void RequestPassedSteps(const FMarkerSyncAnimPosition& Position);
+
+    /** Mesh running the sync group, found on the owner at BeginPlay */
+    UPROPERTY(Transient)
+    TObjectPtr<USkeletalMeshComponent> Mesh;
+
+    /** Position of the sync group on the previous tick, invalid before the first one */
+    FMarkerSyncAnimPosition PreviousPosition;
+
+    /** Marker following each marker of the leader in asset time, learned while following the group */
+    TMap<FName, FName> MarkerSuccessors;
+
+    /** The group leader was last seen moving back in asset time */
+    bool bPlayingBackwards = false;
+};
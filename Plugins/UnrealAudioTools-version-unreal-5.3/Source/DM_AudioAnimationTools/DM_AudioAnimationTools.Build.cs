@@ -41,6 +41,9 @@ public class DM_AudioAnimationTools : ModuleRules
 				"UnrealEd",
 				"Blutility",
 				"UMG",
+				"AssetRegistry",
+				"DerivedDataCache",
+				"DM_SurfaceDetector",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
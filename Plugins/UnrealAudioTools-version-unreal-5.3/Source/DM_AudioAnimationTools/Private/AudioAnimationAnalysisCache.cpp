@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioAnimationAnalysisCache.h"
+
+#include "Animation/AnimSequence.h"
+#include "DerivedDataCacheInterface.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+//Found by the TArray serialization of the tracks
+static FArchive& operator<<(FArchive& Ar, FFootstepAudioData& Footstep)
+{
+	return Ar << Footstep.BoneName << Footstep.FootstepSpeed << Footstep.FootstepTime << Footstep.ContactDuration;
+}
+
+static FArchive& operator<<(FArchive& Ar, FFootContactInterval& Contact)
+{
+	return Ar << Contact.StartTime << Contact.EndTime;
+}
+
+static FArchive& operator<<(FArchive& Ar, FFootstepAudioTrack& Track)
+{
+	return Ar << Track.TrackName << Track.BoneName << Track.Footsteps << Track.GroundContacts << Track.LowestBonePosition << Track.HighestBonePosition << Track.FastestBoneSpeed << Track.SlowestBoneSpeed;
+}
+
+static FArchive& operator<<(FArchive& Ar, FFoleyAudioData& Movement)
+{
+	return Ar << Movement.BoneName << Movement.FoleySpeed << Movement.FoleyLength << Movement.FoleyTime;
+}
+
+static FArchive& operator<<(FArchive& Ar, FFoleyAudioTrack& Track)
+{
+	return Ar << Track.TrackName << Track.FoleyMovements;
+}
+
+namespace AudioAnimationAnalysisCache
+{
+	/**Change it whenever the analysis or the stored data changes, to invalidate all results*/
+	static const TCHAR* Version = TEXT("8B4D1F6A2C9E4E07B3A5D8C1F0E2B964");
+
+	template<typename TrackType>
+	static bool Get(const FString& Key, TArray<TrackType>& OutTracks)
+	{
+		if(Key.IsEmpty())
+		{
+			return false;
+		}
+
+		TArray<uint8> Data;
+		if(!GetDerivedDataCacheRef().GetSynchronous(*Key, Data, TEXT("AudioAnimationAnalysis")))
+		{
+			return false;
+		}
+
+		FMemoryReader Reader(Data);
+		Reader << OutTracks;
+		return !Reader.IsError();
+	}
+
+	template<typename TrackType>
+	static void Put(const FString& Key, const TArray<TrackType>& Tracks)
+	{
+		if(Key.IsEmpty())
+		{
+			return;
+		}
+
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+		Writer << const_cast<TArray<TrackType>&>(Tracks);
+
+		GetDerivedDataCacheRef().Put(*Key, Data, TEXT("AudioAnimationAnalysis"));
+	}
+}
+
+FString FAudioAnimationAnalysisCache::BuildKey(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames,
+	const FAudioAnimationAnalysisSettings& Settings, const TCHAR* Analysis)
+{
+	if(AnimationSequence == nullptr || AnimationSequence->GetSkeleton() == nullptr || AnimationSequence->GetDataModel() == nullptr)
+	{
+		return FString();
+	}
+
+	//Only the settings read by the analysis: sensitivity and edges are applied when writing the notifies
+	FString Parameters = FString::Printf(TEXT("%s_%s_%s_%d_%g_%g_%g_%g_%g_%g"), Analysis,
+		*AnimationSequence->GetDataModel()->GenerateGuid().ToString(),
+		*AnimationSequence->GetSkeleton()->GetGuid().ToString(),
+		static_cast<int>(Settings.FootstepDetectionMethod.GetValue()),
+		Settings.GroundContactStartThreshold, Settings.GroundContactStopMargin, Settings.FootstepSpeedThreshold,
+		Settings.FootstepSpeedCalculationWindow, Settings.FoleySpeedThreshold, Settings.FoleyMinimumMovementDuration);
+
+	for (const FName BoneName : BoneNames)
+	{
+		Parameters += TEXT("_") + BoneName.ToString();
+	}
+
+	//Bone lists make keys of any length
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("DMAUDIOANIM"), AudioAnimationAnalysisCache::Version, *FSHA1::HashBuffer(*Parameters, Parameters.Len() * sizeof(TCHAR)).ToString());
+}
+
+bool FAudioAnimationAnalysisCache::GetFootsteps(const FString& Key, TArray<FFootstepAudioTrack>& OutFootstepTracks)
+{
+	return AudioAnimationAnalysisCache::Get(Key, OutFootstepTracks);
+}
+
+void FAudioAnimationAnalysisCache::PutFootsteps(const FString& Key, const TArray<FFootstepAudioTrack>& FootstepTracks)
+{
+	AudioAnimationAnalysisCache::Put(Key, FootstepTracks);
+}
+
+bool FAudioAnimationAnalysisCache::GetFoley(const FString& Key, TArray<FFoleyAudioTrack>& OutFoleyTracks)
+{
+	return AudioAnimationAnalysisCache::Get(Key, OutFoleyTracks);
+}
+
+void FAudioAnimationAnalysisCache::PutFoley(const FString& Key, const TArray<FFoleyAudioTrack>& FoleyTracks)
+{
+	AudioAnimationAnalysisCache::Put(Key, FoleyTracks);
+}
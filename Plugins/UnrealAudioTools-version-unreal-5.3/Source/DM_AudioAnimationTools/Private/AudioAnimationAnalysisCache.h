@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioAnimationAnalysisTypes.h"
+
+class UAnimSequence;
+
+/**
+ * Analysis results stored in the derived data cache.
+ *
+ * Results are keyed by the animation data model's hash, the skeleton, the bones and the detection settings,
+ * so an analysis only runs again when one of them changed. Shared DDCs share the results between machines.
+ */
+class FAudioAnimationAnalysisCache
+{
+public:
+	/**
+	 * Key of an analysis of these bones with these settings, Analysis telling which one (footsteps or foley).
+	 * Empty if the sequence has no data model or skeleton, in which case nothing is cached.
+	 */
+	static FString BuildKey(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, const FAudioAnimationAnalysisSettings& Settings, const TCHAR* Analysis);
+
+	static bool GetFootsteps(const FString& Key, TArray<FFootstepAudioTrack>& OutFootstepTracks);
+	static void PutFootsteps(const FString& Key, const TArray<FFootstepAudioTrack>& FootstepTracks);
+
+	static bool GetFoley(const FString& Key, TArray<FFoleyAudioTrack>& OutFoleyTracks);
+	static void PutFoley(const FString& Key, const TArray<FFoleyAudioTrack>& FoleyTracks);
+};
@@ -0,0 +1,700 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioAnimationAnalyzer.h"
+
+#include "AudioAnimationAnalysisCache.h"
+#include "AudioAnimationPoseSampler.h"
+#include "AudioAnimationTrajectory.h"
+#include "Animation/AnimComposite.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+
+FAudioAnimationAnalyzer::FAudioAnimationAnalyzer(const FAudioAnimationAnalysisSettings& InSettings)
+	: Settings(InSettings)
+{
+}
+
+void FAudioAnimationAnalyzer::AnalyzeFootsteps(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& OutFootstepTracks) const
+{
+	const FString CacheKey = GetCacheKey(AnimationSequence, BoneNames, TEXT("Footsteps"));
+	if(FAudioAnimationAnalysisCache::GetFootsteps(CacheKey, OutFootstepTracks))
+	{
+		return;
+	}
+
+	switch (Settings.FootstepDetectionMethod) {
+	case HeightThreshold:
+		CalculateFootstepsWithHeightThreshold(AnimationSequence, BoneNames, OutFootstepTracks);
+		break;
+	case TangentCalculation:
+		CalculateFootstepsWithTangents(AnimationSequence, BoneNames, OutFootstepTracks);
+		break;
+	}
+
+	if(HasAllBones(AnimationSequence, BoneNames))
+	{
+		FAudioAnimationAnalysisCache::PutFootsteps(CacheKey, OutFootstepTracks);
+	}
+}
+
+void FAudioAnimationAnalyzer::AnalyzeFoley(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, TArray<FFoleyAudioTrack>& OutFoleyTracks) const
+{
+	OutFoleyTracks.Empty();
+
+	const FString CacheKey = GetCacheKey(AnimationSequence, BoneNames, TEXT("Foley"));
+	if(FAudioAnimationAnalysisCache::GetFoley(CacheKey, OutFoleyTracks))
+	{
+		return;
+	}
+
+	TArray<FName> SampledBoneNames;
+	TArray<int> SampledBoneIndexes;
+	if(!FindBones(AnimationSequence, BoneNames, TEXT("AutoGenerateFoleyNotifies"), SampledBoneNames, SampledBoneIndexes))
+	{
+		return;
+	}
+
+	//Evaluate every pose once for all bones
+	TArray<float> SampleTimes;
+	GetSampleTimes(AnimationSequence, SampleTimes);
+
+	FAudioAnimationPoseSampler PoseSampler(AnimationSequence, SampledBoneIndexes);
+	FAudioAnimationTrajectories Trajectories;
+	PoseSampler.SampleBoneTrajectories(SampleTimes, Trajectories);
+
+	TArray<float> BoneSpeeds;
+	TArray<bool> TooSlow;
+	BoneSpeeds.SetNumUninitialized(SampleTimes.Num());
+	TooSlow.SetNumUninitialized(SampleTimes.Num());
+
+	for (int SampledBone = 0; SampledBone < SampledBoneNames.Num(); SampledBone++)
+	{
+		const FName BoneName = SampledBoneNames[SampledBone];
+
+		AudioAnimationKernels::Speeds(Trajectories.X[SampledBone], Trajectories.Y[SampledBone], Trajectories.Z[SampledBone], Trajectories.InverseIntervals, BoneSpeeds);
+		AudioAnimationKernels::Less(BoneSpeeds, Settings.FoleySpeedThreshold, TooSlow);
+
+		FFoleyAudioTrack& NewFoleyTrack = OutFoleyTracks.AddDefaulted_GetRef();
+		NewFoleyTrack.TrackName = FName(*("AutoGen " + BoneName.ToString()));
+
+		float MovingSinceTime = -1.0f;
+		for (int TimeIndex = 1; TimeIndex < SampleTimes.Num(); TimeIndex++)
+		{
+			const float Time = SampleTimes[TimeIndex];
+			const float PreviousBoneSpeed = BoneSpeeds[TimeIndex - 1];
+
+			const bool Moving = !TooSlow[TimeIndex] && BoneSpeeds[TimeIndex] >= PreviousBoneSpeed;
+
+			if(Moving && MovingSinceTime < 0.0f) //Started moving
+			{
+				MovingSinceTime = Time;
+			}
+			else if(!Moving && MovingSinceTime >= 0.0f) //Stopped moving
+			{
+				const float MovementDuration = Time - MovingSinceTime;
+
+				if(MovementDuration >= Settings.FoleyMinimumMovementDuration)
+				{
+					FFoleyAudioData& NewFoleyAudioData = NewFoleyTrack.FoleyMovements.AddDefaulted_GetRef();
+					NewFoleyAudioData.BoneName = BoneName;
+					NewFoleyAudioData.FoleyTime = MovingSinceTime;
+					NewFoleyAudioData.FoleyLength = MovementDuration;
+					NewFoleyAudioData.FoleySpeed = PreviousBoneSpeed;
+				}
+
+				MovingSinceTime = -1.0f;
+			}
+		}
+	}
+
+	if(HasAllBones(AnimationSequence, BoneNames))
+	{
+		FAudioAnimationAnalysisCache::PutFoley(CacheKey, OutFoleyTracks);
+	}
+}
+
+void FAudioAnimationAnalyzer::AnalyzeSegmentFootsteps(const UAnimSequenceBase* Animation, const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& OutFootstepTracks) const
+{
+	OutFootstepTracks.Empty();
+
+	if(const UAnimSequence* AnimationSequence = Cast<UAnimSequence>(Animation))
+	{
+		AnalyzeFootsteps(AnimationSequence, BoneNames, OutFootstepTracks);
+		return;
+	}
+
+	TArray<const FAnimSegment*> Segments;
+	GetSequenceSegments(Animation, Segments);
+
+	//Sequences looped or reused by several segments are analyzed once
+	TMap<const UAnimSequence*, TArray<FFootstepAudioTrack>> SequenceTracks;
+
+	for (const FAnimSegment* Segment : Segments)
+	{
+		const UAnimSequence* SegmentSequence = CastChecked<UAnimSequence>(Segment->GetAnimReference());
+		if(!SequenceTracks.Contains(SegmentSequence))
+		{
+			AnalyzeFootsteps(SegmentSequence, BoneNames, SequenceTracks.Add(SegmentSequence));
+		}
+
+		const float SegmentLength = Segment->AnimEndTime - Segment->AnimStartTime;
+		const float PlayRate = FMath::Abs(Segment->AnimPlayRate);
+		if(SegmentLength <= 0.0f || PlayRate <= 0.0f)
+		{
+			continue;
+		}
+
+		for (const FFootstepAudioTrack& SequenceTrack : SequenceTracks[SegmentSequence])
+		{
+			//One track per bone, whatever the number of segments
+			FFootstepAudioTrack* FootstepTrack = OutFootstepTracks.FindByPredicate([&SequenceTrack](const FFootstepAudioTrack& Track){return Track.TrackName == SequenceTrack.TrackName;});
+			if(FootstepTrack == nullptr)
+			{
+				FootstepTrack = &OutFootstepTracks.AddDefaulted_GetRef();
+				FootstepTrack->TrackName = SequenceTrack.TrackName;
+				FootstepTrack->BoneName = SequenceTrack.BoneName;
+				FootstepTrack->LowestBonePosition = SequenceTrack.LowestBonePosition;
+				FootstepTrack->HighestBonePosition = SequenceTrack.HighestBonePosition;
+				FootstepTrack->FastestBoneSpeed = SequenceTrack.FastestBoneSpeed;
+				FootstepTrack->SlowestBoneSpeed = SequenceTrack.SlowestBoneSpeed;
+			}
+
+			FootstepTrack->LowestBonePosition = FMath::Min(FootstepTrack->LowestBonePosition, SequenceTrack.LowestBonePosition);
+			FootstepTrack->HighestBonePosition = FMath::Max(FootstepTrack->HighestBonePosition, SequenceTrack.HighestBonePosition);
+			FootstepTrack->FastestBoneSpeed = FMath::Max(FootstepTrack->FastestBoneSpeed, SequenceTrack.FastestBoneSpeed);
+			if(SequenceTrack.SlowestBoneSpeed >= 0.0f && (FootstepTrack->SlowestBoneSpeed < 0.0f || SequenceTrack.SlowestBoneSpeed < FootstepTrack->SlowestBoneSpeed))
+			{
+				FootstepTrack->SlowestBoneSpeed = SequenceTrack.SlowestBoneSpeed;
+			}
+
+			for (int Loop = 0; Loop < FMath::Max(Segment->LoopingCount, 1); Loop++)
+			{
+				for (const FFootstepAudioData& SequenceFootstep : SequenceTrack.Footsteps)
+				{
+					if(SequenceFootstep.FootstepTime < Segment->AnimStartTime || SequenceFootstep.FootstepTime >= Segment->AnimEndTime)
+					{
+						continue;
+					}
+
+					//Reversed segments play from their end: the foot lands where the contact ends in the sequence, and the contact stops at the segment end
+					const float ContactEnd = FMath::Min(SequenceFootstep.FootstepTime + SequenceFootstep.ContactDuration, Segment->AnimEndTime);
+					const float SegmentTime = Segment->AnimPlayRate > 0.0f ? SequenceFootstep.FootstepTime - Segment->AnimStartTime : Segment->AnimEndTime - ContactEnd;
+					const float ContactDuration = Segment->AnimPlayRate > 0.0f ? SequenceFootstep.ContactDuration : ContactEnd - SequenceFootstep.FootstepTime;
+
+					FFootstepAudioData& Footstep = FootstepTrack->Footsteps.Add_GetRef(SequenceFootstep);
+					Footstep.FootstepTime = Segment->StartPos + (Loop * SegmentLength + SegmentTime) / PlayRate;
+					Footstep.ContactDuration = ContactDuration / PlayRate;
+				}
+
+				for (const FFootContactInterval& SequenceContact : SequenceTrack.GroundContacts)
+				{
+					//Only the part of the contact inside the segment
+					const float ContactStart = FMath::Max(SequenceContact.StartTime, Segment->AnimStartTime);
+					const float ContactEnd = FMath::Min(SequenceContact.EndTime, Segment->AnimEndTime);
+					if(ContactEnd <= ContactStart)
+					{
+						continue;
+					}
+
+					//Reversed segments play from their end, swapping the contact start and end
+					const float SegmentStart = Segment->AnimPlayRate > 0.0f ? ContactStart - Segment->AnimStartTime : Segment->AnimEndTime - ContactEnd;
+					const float SegmentEnd = Segment->AnimPlayRate > 0.0f ? ContactEnd - Segment->AnimStartTime : Segment->AnimEndTime - ContactStart;
+
+					FFootContactInterval& Contact = FootstepTrack->GroundContacts.AddDefaulted_GetRef();
+					Contact.StartTime = Segment->StartPos + (Loop * SegmentLength + SegmentStart) / PlayRate;
+					Contact.EndTime = Segment->StartPos + (Loop * SegmentLength + SegmentEnd) / PlayRate;
+				}
+			}
+		}
+	}
+
+	for (FFootstepAudioTrack& FootstepTrack : OutFootstepTracks)
+	{
+		FootstepTrack.Footsteps.Sort([](const FFootstepAudioData& A, const FFootstepAudioData& B){return A.FootstepTime < B.FootstepTime;});
+		FootstepTrack.GroundContacts.Sort([](const FFootContactInterval& A, const FFootContactInterval& B){return A.StartTime < B.StartTime;});
+	}
+}
+
+void FAudioAnimationAnalyzer::AnalyzeSegmentFoley(const UAnimSequenceBase* Animation, const TArray<FName>& BoneNames, TArray<FFoleyAudioTrack>& OutFoleyTracks) const
+{
+	OutFoleyTracks.Empty();
+
+	if(const UAnimSequence* AnimationSequence = Cast<UAnimSequence>(Animation))
+	{
+		AnalyzeFoley(AnimationSequence, BoneNames, OutFoleyTracks);
+		return;
+	}
+
+	TArray<const FAnimSegment*> Segments;
+	GetSequenceSegments(Animation, Segments);
+
+	//Sequences looped or reused by several segments are analyzed once
+	TMap<const UAnimSequence*, TArray<FFoleyAudioTrack>> SequenceTracks;
+
+	for (const FAnimSegment* Segment : Segments)
+	{
+		const UAnimSequence* SegmentSequence = CastChecked<UAnimSequence>(Segment->GetAnimReference());
+		if(!SequenceTracks.Contains(SegmentSequence))
+		{
+			AnalyzeFoley(SegmentSequence, BoneNames, SequenceTracks.Add(SegmentSequence));
+		}
+
+		const float SegmentLength = Segment->AnimEndTime - Segment->AnimStartTime;
+		const float PlayRate = FMath::Abs(Segment->AnimPlayRate);
+		if(SegmentLength <= 0.0f || PlayRate <= 0.0f)
+		{
+			continue;
+		}
+
+		for (const FFoleyAudioTrack& SequenceTrack : SequenceTracks[SegmentSequence])
+		{
+			FFoleyAudioTrack* FoleyTrack = OutFoleyTracks.FindByPredicate([&SequenceTrack](const FFoleyAudioTrack& Track){return Track.TrackName == SequenceTrack.TrackName;});
+			if(FoleyTrack == nullptr)
+			{
+				FoleyTrack = &OutFoleyTracks.AddDefaulted_GetRef();
+				FoleyTrack->TrackName = SequenceTrack.TrackName;
+			}
+
+			for (int Loop = 0; Loop < FMath::Max(Segment->LoopingCount, 1); Loop++)
+			{
+				for (const FFoleyAudioData& SequenceMovement : SequenceTrack.FoleyMovements)
+				{
+					if(SequenceMovement.FoleyTime < Segment->AnimStartTime || SequenceMovement.FoleyTime >= Segment->AnimEndTime)
+					{
+						continue;
+					}
+
+					//Reversed segments play the movement from its end
+					const float SegmentTime = Segment->AnimPlayRate > 0.0f ? SequenceMovement.FoleyTime - Segment->AnimStartTime
+						: FMath::Max(Segment->AnimEndTime - SequenceMovement.FoleyTime - SequenceMovement.FoleyLength, 0.0f);
+
+					FFoleyAudioData& Movement = FoleyTrack->FoleyMovements.Add_GetRef(SequenceMovement);
+					Movement.FoleyTime = Segment->StartPos + (Loop * SegmentLength + SegmentTime) / PlayRate;
+					Movement.FoleyLength = SequenceMovement.FoleyLength / PlayRate;
+				}
+			}
+		}
+	}
+
+	for (FFoleyAudioTrack& FoleyTrack : OutFoleyTracks)
+	{
+		FoleyTrack.FoleyMovements.Sort([](const FFoleyAudioData& A, const FFoleyAudioData& B){return A.FoleyTime < B.FoleyTime;});
+	}
+}
+
+void FAudioAnimationAnalyzer::GetSequenceSegments(const UAnimSequenceBase* Animation, TArray<const FAnimSegment*>& OutSegments)
+{
+	const FAnimTrack* AnimTrack = nullptr;
+	if(const UAnimMontage* Montage = Cast<UAnimMontage>(Animation))
+	{
+		//Other slots usually layer partial body animations over the first one
+		AnimTrack = Montage->SlotAnimTracks.Num() > 0 ? &Montage->SlotAnimTracks[0].AnimTrack : nullptr;
+	}
+	else if(const UAnimComposite* Composite = Cast<UAnimComposite>(Animation))
+	{
+		AnimTrack = &Composite->AnimationTrack;
+	}
+
+	if(AnimTrack == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationAnalyzer -- AnalyzeSegments : %s is not a montage or a composite with a slot track. Early exit."), *GetNameSafe(Animation));
+		return;
+	}
+
+	for (const FAnimSegment& Segment : AnimTrack->AnimSegments)
+	{
+		if(Cast<UAnimSequence>(Segment.GetAnimReference()) != nullptr)
+		{
+			OutSegments.Add(&Segment);
+		}
+	}
+}
+
+FString FAudioAnimationAnalyzer::GetCacheKey(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, const TCHAR* Analysis) const
+{
+	//Verbose analyses run for their logs
+	if(!Settings.UseAnalysisCache || Settings.VerboseLogging)
+	{
+		return FString();
+	}
+
+	return FAudioAnimationAnalysisCache::BuildKey(AnimationSequence, BoneNames, Settings, Analysis);
+}
+
+bool FAudioAnimationAnalyzer::FindBones(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, const TCHAR* Caller,
+	TArray<FName>& OutBoneNames, TArray<int>& OutBoneIndexes)
+{
+	if(AnimationSequence == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationAnalyzer -- %s : passed a null AnimSequence. Early exit."), Caller);
+		return false;
+	}
+
+	const USkeleton* Skeleton = AnimationSequence->GetSkeleton();
+
+	if(Skeleton == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationAnalyzer -- %s : AnimSequence had a null skeleton. Early exit."), Caller);
+		return false;
+	}
+
+	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+
+	for (FName BoneName : BoneNames)
+	{
+		const int BoneIndex = ReferenceSkeleton.FindBoneIndex(BoneName);
+		if(BoneIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("AudioAnimationAnalyzer -- %s : Bone %s does not exist, skipping it"), Caller, *BoneName.ToString());
+		}
+		else if(!OutBoneNames.Contains(BoneName))
+		{
+			OutBoneNames.Add(BoneName);
+			OutBoneIndexes.Add(BoneIndex);
+		}
+	}
+
+	return true;
+}
+
+bool FAudioAnimationAnalyzer::HasAllBones(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames)
+{
+	const USkeleton* Skeleton = AnimationSequence ? AnimationSequence->GetSkeleton() : nullptr;
+	if(Skeleton == nullptr)
+	{
+		return false;
+	}
+
+	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+	for (const FName BoneName : BoneNames)
+	{
+		if(ReferenceSkeleton.FindBoneIndex(BoneName) == INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FAudioAnimationAnalyzer::CalculateFootstepsWithHeightThreshold(const UAnimSequence* AnimationSequence,
+	const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks) const
+{
+	FootstepTracks.Empty();
+
+	TArray<FName> SampledBoneNames;
+	TArray<int> SampledBoneIndexes;
+	if(!FindBones(AnimationSequence, BoneNames, TEXT("AutoGenerateFootstepNotifies"), SampledBoneNames, SampledBoneIndexes))
+	{
+		return;
+	}
+
+	//Evaluate every pose once for all bones
+	TArray<float> SampleTimes;
+	GetSampleTimes(AnimationSequence, SampleTimes);
+
+	FAudioAnimationPoseSampler PoseSampler(AnimationSequence, SampledBoneIndexes);
+	FAudioAnimationTrajectories Trajectories;
+	PoseSampler.SampleBoneTrajectories(SampleTimes, Trajectories);
+
+	TArray<bool> BelowStartThreshold;
+	TArray<bool> BelowStopThreshold;
+	BelowStartThreshold.SetNumUninitialized(SampleTimes.Num());
+	BelowStopThreshold.SetNumUninitialized(SampleTimes.Num());
+
+	for (int SampledBone = 0; SampledBone < SampledBoneNames.Num(); SampledBone++)
+	{
+		const FName BoneName = SampledBoneNames[SampledBone];
+		const TArray<float>& BoneHeights = Trajectories.Z[SampledBone];
+
+		AudioAnimationKernels::LessOrEqual(BoneHeights, Settings.GroundContactStartThreshold, BelowStartThreshold);
+		AudioAnimationKernels::LessOrEqual(BoneHeights, Settings.GroundContactStartThreshold + Settings.GroundContactStopMargin, BelowStopThreshold);
+
+		FFootstepAudioTrack& NewFootstepTrack = FootstepTracks.AddDefaulted_GetRef();
+		NewFootstepTrack.TrackName = FName(*("AutoGen " + BoneName.ToString()));
+		NewFootstepTrack.BoneName = BoneName;
+
+		//A foot already on the ground at the start is in contact, without a footstep
+		float GroundContactSinceTime = BelowStartThreshold[0] ? 0.0f : -1.0f;
+		bool FootstepContact = false; //The current contact started with a footstep
+		//Debug values tracking
+		AudioAnimationKernels::MinMax(BoneHeights, NewFootstepTrack.LowestBonePosition, NewFootstepTrack.HighestBonePosition);
+		NewFootstepTrack.FastestBoneSpeed = 0.0f;
+		NewFootstepTrack.SlowestBoneSpeed = -1.0f;
+		
+		for (int TimeIndex = 1; TimeIndex < SampleTimes.Num(); TimeIndex++)
+		{
+			const float Time = SampleTimes[TimeIndex];
+
+			const bool GroundContact = GroundContactSinceTime < 0.0f? BelowStartThreshold[TimeIndex] : BelowStopThreshold[TimeIndex];
+
+			if(Settings.VerboseLogging)
+			{
+				UE_LOG(LogTemp, Log, TEXT("AudioAnimationTools : Bone %s height on time %f was %f units."), *BoneName.ToString(), Time, BoneHeights[TimeIndex]);
+			}
+			
+			if(GroundContact && GroundContactSinceTime < 0.0f) //New footstep!
+			{
+				//The foot touched the ground somewhere since the previous frame
+				FVector ContactLocation;
+				const float ContactTime = RefineHeightCrossing(PoseSampler, SampledBone, SampleTimes[TimeIndex - 1], Time, Trajectories.GetLocation(SampledBone, TimeIndex), Settings.GroundContactStartThreshold, ContactLocation);
+
+				if(Settings.VerboseLogging)
+				{
+					UE_LOG(LogTemp, Log, TEXT("AudioAnimationTools : Bone %s did a footstep on time %f"), *BoneName.ToString(), ContactTime);
+				}
+				
+				GroundContactSinceTime = ContactTime;
+				FootstepContact = true;
+
+				//One extra pose per footstep, for the speed window
+				PoseSampler.Evaluate(ContactTime-Settings.FootstepSpeedCalculationWindow);
+				FVector PastFootLocation = PoseSampler.GetBoneLocation(SampledBone);
+				const float FootSpeed = ((ContactLocation - PastFootLocation)/Settings.FootstepSpeedCalculationWindow).Size();
+				FFootstepAudioData& NewFootstep = NewFootstepTrack.Footsteps.AddDefaulted_GetRef();
+				NewFootstep.BoneName = BoneName;
+				NewFootstep.FootstepTime = ContactTime;
+				NewFootstep.FootstepSpeed = FootSpeed;
+
+				//Values for filtering
+				if(FootSpeed < NewFootstepTrack.SlowestBoneSpeed || NewFootstepTrack.SlowestBoneSpeed == -1.0f) NewFootstepTrack.SlowestBoneSpeed = FootSpeed;
+				if(FootSpeed > NewFootstepTrack.FastestBoneSpeed) NewFootstepTrack.FastestBoneSpeed = FootSpeed;
+			}
+			else if(!GroundContact && GroundContactSinceTime >= 0.0f) //Foot stopped touching ground
+			{
+				FFootContactInterval& Contact = NewFootstepTrack.GroundContacts.AddDefaulted_GetRef();
+				Contact.StartTime = GroundContactSinceTime;
+				Contact.EndTime = Time;
+
+				if(FootstepContact)
+				{
+					NewFootstepTrack.Footsteps.Last().ContactDuration = Time - GroundContactSinceTime;
+					FootstepContact = false;
+				}
+
+				GroundContactSinceTime = -1.0f;
+
+				if(Settings.VerboseLogging)
+				{
+					UE_LOG(LogTemp, Log, TEXT("AudioAnimationTools : Bone %s stopped touching ground on time %f"), *BoneName.ToString(), Time);
+				}
+			}
+		}
+
+		//Still on the ground at the end
+		if(GroundContactSinceTime >= 0.0f)
+		{
+			FFootContactInterval& Contact = NewFootstepTrack.GroundContacts.AddDefaulted_GetRef();
+			Contact.StartTime = GroundContactSinceTime;
+			Contact.EndTime = AnimationSequence->GetPlayLength();
+		}
+
+		if(FootstepContact)
+		{
+			NewFootstepTrack.Footsteps.Last().ContactDuration = SampleTimes.Last() - GroundContactSinceTime;
+		}
+	}
+}
+
+void FAudioAnimationAnalyzer::CalculateFootstepsWithTangents(const UAnimSequence* AnimationSequence,
+	const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks) const
+{
+	FootstepTracks.Empty();
+
+	TArray<FName> SampledBoneNames;
+	TArray<int> SampledBoneIndexes;
+	if(!FindBones(AnimationSequence, BoneNames, TEXT("CalculateFootstepsWithTangents"), SampledBoneNames, SampledBoneIndexes))
+	{
+		return;
+	}
+
+	//Evaluate every pose once for all bones
+	TArray<float> SampleTimes;
+	GetSampleTimes(AnimationSequence, SampleTimes);
+
+	FAudioAnimationPoseSampler PoseSampler(AnimationSequence, SampledBoneIndexes);
+	FAudioAnimationTrajectories Trajectories;
+	PoseSampler.SampleBoneTrajectories(SampleTimes, Trajectories);
+
+	TArray<float> BoneSpeeds;
+	TArray<float> VerticalSpeeds;
+	TArray<bool> GoingDown;
+	BoneSpeeds.SetNumUninitialized(SampleTimes.Num());
+	VerticalSpeeds.SetNumUninitialized(SampleTimes.Num());
+	GoingDown.SetNumUninitialized(SampleTimes.Num());
+
+	//The threshold is a distance per reference interval, whatever the frame rate of the animation
+	const float GoingDownSpeed = -Settings.FootstepSpeedThreshold / ReferenceTimeIncrement;
+
+	for (int SampledBone = 0; SampledBone < SampledBoneNames.Num(); SampledBone++)
+	{
+		const FName BoneName = SampledBoneNames[SampledBone];
+
+		AudioAnimationKernels::Speeds(Trajectories.X[SampledBone], Trajectories.Y[SampledBone], Trajectories.Z[SampledBone], Trajectories.InverseIntervals, BoneSpeeds);
+		AudioAnimationKernels::Derivative(Trajectories.Z[SampledBone], Trajectories.InverseIntervals, VerticalSpeeds);
+		AudioAnimationKernels::Less(VerticalSpeeds, GoingDownSpeed, GoingDown);
+
+		FFootstepAudioTrack& NewFootstepTrack = FootstepTracks.AddDefaulted_GetRef();
+		NewFootstepTrack.TrackName = FName(*("AutoGen " + BoneName.ToString()));
+		NewFootstepTrack.BoneName = BoneName;
+
+		//Debug values tracking
+		AudioAnimationKernels::MinMax(Trajectories.Z[SampledBone], NewFootstepTrack.LowestBonePosition, NewFootstepTrack.HighestBonePosition);
+		NewFootstepTrack.FastestBoneSpeed = 0.0f;
+		NewFootstepTrack.SlowestBoneSpeed = -1.0f;
+		
+		//Height the foot has to rise above to end the current contact, if still on the ground
+		float ContactStopHeight = TNumericLimits<float>::Max();
+		float GroundContactSinceTime = -1.0f;
+		bool FootstepContact = false; //The current contact started with a footstep
+
+		//Without a footstep to tell the ground height, a foot at its lowest at the start is already on the ground
+		if(Trajectories.Z[SampledBone][0] <= NewFootstepTrack.LowestBonePosition + Settings.GroundContactStopMargin)
+		{
+			ContactStopHeight = NewFootstepTrack.LowestBonePosition + Settings.GroundContactStopMargin;
+			GroundContactSinceTime = 0.0f;
+		}
+
+		for (int TimeIndex = 1; TimeIndex < SampleTimes.Num(); TimeIndex++)
+		{
+			if(Trajectories.Z[SampledBone][TimeIndex] > ContactStopHeight) //Foot left the ground
+			{
+				FFootContactInterval& Contact = NewFootstepTrack.GroundContacts.AddDefaulted_GetRef();
+				Contact.StartTime = GroundContactSinceTime;
+				Contact.EndTime = SampleTimes[TimeIndex];
+
+				if(FootstepContact)
+				{
+					FFootstepAudioData& LastFootstep = NewFootstepTrack.Footsteps.Last();
+					LastFootstep.ContactDuration = SampleTimes[TimeIndex] - LastFootstep.FootstepTime;
+					FootstepContact = false;
+				}
+
+				ContactStopHeight = TNumericLimits<float>::Max();
+				GroundContactSinceTime = -1.0f;
+			}
+
+			if(!GoingDown[TimeIndex] && GoingDown[TimeIndex - 1]) //Footstep!
+			{
+				//The foot stopped going down somewhere since the previous frame
+				FVector ContactLocation;
+				const float ContactTime = RefineLowestHeight(PoseSampler, SampledBone, SampleTimes[TimeIndex - 1], SampleTimes[TimeIndex], ContactLocation);
+				if(ContactLocation.Z < NewFootstepTrack.LowestBonePosition) NewFootstepTrack.LowestBonePosition = ContactLocation.Z;
+
+				//Distance over the last frame, per reference interval
+				const float FootSpeed = BoneSpeeds[TimeIndex]*ReferenceTimeIncrement/Settings.FootstepSpeedCalculationWindow;
+				FFootstepAudioData& NewFootstep = NewFootstepTrack.Footsteps.AddDefaulted_GetRef();
+				NewFootstep.BoneName = BoneName;
+				NewFootstep.FootstepTime = ContactTime;
+				NewFootstep.FootstepSpeed = FootSpeed;
+				NewFootstep.ContactDuration = SampleTimes.Last() - ContactTime; //Until the foot leaves the ground, or the end
+				ContactStopHeight = ContactLocation.Z + Settings.GroundContactStopMargin;
+				FootstepContact = true;
+
+				//A footstep while still on the ground carries on the same contact
+				if(GroundContactSinceTime < 0.0f)
+				{
+					GroundContactSinceTime = ContactTime;
+				}
+
+				//Values for filtering
+				if(FootSpeed < NewFootstepTrack.SlowestBoneSpeed || NewFootstepTrack.SlowestBoneSpeed == -1.0f) NewFootstepTrack.SlowestBoneSpeed = FootSpeed;
+				if(FootSpeed > NewFootstepTrack.FastestBoneSpeed) NewFootstepTrack.FastestBoneSpeed = FootSpeed;
+			}
+		}
+
+		//Still on the ground at the end
+		if(GroundContactSinceTime >= 0.0f)
+		{
+			FFootContactInterval& Contact = NewFootstepTrack.GroundContacts.AddDefaulted_GetRef();
+			Contact.StartTime = GroundContactSinceTime;
+			Contact.EndTime = AnimationSequence->GetPlayLength();
+		}
+	}
+}
+
+void FAudioAnimationAnalyzer::GetSampleTimes(const UAnimSequence* AnimationSequence, TArray<float>& OutTimes)
+{
+	OutTimes.Reset();
+
+	//Every key of the animation, no more no less: in between poses are interpolated
+	const FFrameRate FrameRate = AnimationSequence->GetSamplingFrameRate();
+	const double PlayLength = AnimationSequence->GetPlayLength();
+	OutTimes.Add(0.0f);
+	for (int Frame = 1; FrameRate.AsSeconds(FFrameTime(Frame)) < PlayLength; Frame++)
+	{
+		OutTimes.Add(FrameRate.AsSeconds(FFrameTime(Frame)));
+	}
+}
+
+double FAudioAnimationAnalyzer::RefineHeightCrossing(FAudioAnimationPoseSampler& PoseSampler, const int SampledBone, const double StartTime, const double EndTime,
+	const FVector& EndLocation, const float Height, FVector& OutLocation) const
+{
+	double AboveTime = StartTime;
+	double BelowTime = EndTime;
+	OutLocation = EndLocation;
+
+	while(BelowTime - AboveTime > ContactTimeTolerance)
+	{
+		const double MiddleTime = 0.5 * (AboveTime + BelowTime);
+		PoseSampler.Evaluate(MiddleTime);
+		const FVector MiddleLocation = PoseSampler.GetBoneLocation(SampledBone);
+
+		if(MiddleLocation.Z <= Height)
+		{
+			BelowTime = MiddleTime;
+			OutLocation = MiddleLocation;
+		}
+		else
+		{
+			AboveTime = MiddleTime;
+		}
+	}
+
+	return BelowTime;
+}
+
+double FAudioAnimationAnalyzer::RefineLowestHeight(FAudioAnimationPoseSampler& PoseSampler, const int SampledBone, double StartTime, double EndTime,
+	FVector& OutLocation) const
+{
+	const double InverseGoldenRatio = 0.5 * (FMath::Sqrt(5.0) - 1.0);
+
+	auto GetHeight = [&PoseSampler, SampledBone](const double Time)
+	{
+		PoseSampler.Evaluate(Time);
+		return PoseSampler.GetBoneLocation(SampledBone).Z;
+	};
+
+	//One new pose per iteration: the interval shrinks around the lower of its two inner points
+	double LeftTime = EndTime - InverseGoldenRatio * (EndTime - StartTime);
+	double RightTime = StartTime + InverseGoldenRatio * (EndTime - StartTime);
+	double LeftHeight = GetHeight(LeftTime);
+	double RightHeight = GetHeight(RightTime);
+
+	while(EndTime - StartTime > ContactTimeTolerance)
+	{
+		if(LeftHeight < RightHeight)
+		{
+			EndTime = RightTime;
+			RightTime = LeftTime;
+			RightHeight = LeftHeight;
+			LeftTime = EndTime - InverseGoldenRatio * (EndTime - StartTime);
+			LeftHeight = GetHeight(LeftTime);
+		}
+		else
+		{
+			StartTime = LeftTime;
+			LeftTime = RightTime;
+			LeftHeight = RightHeight;
+			RightTime = StartTime + InverseGoldenRatio * (EndTime - StartTime);
+			RightHeight = GetHeight(RightTime);
+		}
+	}
+
+	const double LowestTime = 0.5 * (StartTime + EndTime);
+	PoseSampler.Evaluate(LowestTime);
+	OutLocation = PoseSampler.GetBoneLocation(SampledBone);
+
+	return LowestTime;
+}
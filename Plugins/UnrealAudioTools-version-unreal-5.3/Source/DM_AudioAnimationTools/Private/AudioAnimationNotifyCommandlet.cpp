@@ -0,0 +1,322 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioAnimationNotifyCommandlet.h"
+
+#include "AudioAnimationAnalyzer.h"
+#include "AudioAnimationNotifyWriter.h"
+#include "Algo/Transform.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "Animation/AnimSequence.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UAudioAnimationNotifyCommandlet::UAudioAnimationNotifyCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAudioAnimationNotifyCommandlet::Main(const FString& Params)
+{
+	FString PathsValue;
+	if(!FParse::Value(*Params, TEXT("Paths="), PathsValue, false))
+	{
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationNotify : missing -Paths=<Path+Path>"));
+		return 1;
+	}
+
+	TArray<FString> Paths;
+	PathsValue.ParseIntoArray(Paths, TEXT("+"));
+
+	FString FootstepBonesValue;
+	FString FoleyBonesValue;
+	FParse::Value(*Params, TEXT("FootstepBones="), FootstepBonesValue, false);
+	FParse::Value(*Params, TEXT("FoleyBones="), FoleyBonesValue, false);
+
+	TArray<FString> BoneStrings;
+	TArray<FName> FootstepBones;
+	FootstepBonesValue.ParseIntoArray(BoneStrings, TEXT(","));
+	Algo::Transform(BoneStrings, FootstepBones, [](const FString& Bone){ return FName(*Bone); });
+	TArray<FName> FoleyBones;
+	FoleyBonesValue.ParseIntoArray(BoneStrings, TEXT(","));
+	Algo::Transform(BoneStrings, FoleyBones, [](const FString& Bone){ return FName(*Bone); });
+
+	const TSubclassOf<UAnimNotify> FootstepNotifyClass = LoadNotifyClass(Params, TEXT("FootstepNotify="));
+	const TSubclassOf<UAnimNotify> FoleyNotifyClass = LoadNotifyClass(Params, TEXT("FoleyNotify="));
+
+	const FFootstepOutputSettings FootstepOutput = ParseFootstepOutput(Params, FootstepNotifyClass != nullptr);
+
+	const bool bFootsteps = FootstepBones.Num() > 0 && (FootstepOutput.WriteNotifies || FootstepOutput.WriteSyncMarkers || FootstepOutput.WriteContactCurves || FootstepOutput.WriteTimingData);
+	const bool bFoley = FoleyBones.Num() > 0 && FoleyNotifyClass != nullptr;
+	if(!bFootsteps && !bFoley)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationNotify : nothing to do, give -FootstepBones= with -FootstepNotify=, -SyncMarkers=, -ContactCurves or -TimingData, or -FoleyBones= and -FoleyNotify="));
+		return 1;
+	}
+
+	const FAudioAnimationAnalyzer Analyzer(ParseSettings(Params));
+
+	int BatchSize = 64;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(BatchSize, 1);
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	//Find the sequences without loading them
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+
+	TArray<FAssetData> SequenceAssets;
+	AssetRegistry.GetAssets(Filter, SequenceAssets);
+
+	UE_LOG(LogTemp, Display, TEXT("AudioAnimationNotify : %d animation sequences found under %s"), SequenceAssets.Num(), *PathsValue);
+
+	TArray<FSequenceReport> Reports;
+	Reports.Reserve(SequenceAssets.Num());
+
+	//Sequences are loaded by batches, so the whole library never sits in memory
+	for (int BatchStart = 0; BatchStart < SequenceAssets.Num(); BatchStart += BatchSize)
+	{
+		const int BatchEnd = FMath::Min(BatchStart + BatchSize, SequenceAssets.Num());
+		const int BatchNum = BatchEnd - BatchStart;
+
+		TArray<UAnimSequence*> Sequences;
+		for (int AssetIndex = BatchStart; AssetIndex < BatchEnd; AssetIndex++)
+		{
+			Sequences.Add(Cast<UAnimSequence>(SequenceAssets[AssetIndex].GetAsset()));
+		}
+
+		TArray<TArray<FFootstepAudioTrack>> FootstepTracks;
+		TArray<TArray<FFoleyAudioTrack>> FoleyTracks;
+		FootstepTracks.SetNum(BatchNum);
+		FoleyTracks.SetNum(BatchNum);
+
+		ParallelFor(BatchNum, [&](const int SequenceIndex)
+		{
+			if(Sequences[SequenceIndex] == nullptr)
+			{
+				return;
+			}
+
+			if(bFootsteps)
+			{
+				Analyzer.AnalyzeFootsteps(Sequences[SequenceIndex], FootstepBones, FootstepTracks[SequenceIndex]);
+			}
+			if(bFoley)
+			{
+				Analyzer.AnalyzeFoley(Sequences[SequenceIndex], FoleyBones, FoleyTracks[SequenceIndex]);
+			}
+		});
+
+		//Notifies are written and packages saved on the game thread
+		for (int SequenceIndex = 0; SequenceIndex < BatchNum; SequenceIndex++)
+		{
+			FSequenceReport& Report = Reports.AddDefaulted_GetRef();
+			Report.PackageName = SequenceAssets[BatchStart + SequenceIndex].PackageName.ToString();
+
+			UAnimSequence* Sequence = Sequences[SequenceIndex];
+			if(Sequence == nullptr)
+			{
+				Report.Error = TEXT("Failed to load");
+				continue;
+			}
+
+			if(bFootsteps)
+			{
+				TMap<UAnimNotify*, FFootstepAudioData> CreatedNotifies;
+				Report.bModified |= FAudioAnimationNotifyWriter::WriteFootsteps(Sequence, FootstepTracks[SequenceIndex], FootstepNotifyClass, Analyzer.GetSettings(), FootstepOutput, CreatedNotifies);
+				Report.NumFootsteps = CreatedNotifies.Num();
+			}
+			if(bFoley)
+			{
+				TMap<UAnimNotify*, FFoleyAudioData> CreatedNotifies;
+				Report.bModified |= FAudioAnimationNotifyWriter::WriteFoleyNotifies(Sequence, FoleyTracks[SequenceIndex], FoleyNotifyClass, CreatedNotifies);
+				Report.NumFoleyMovements = CreatedNotifies.Num();
+			}
+
+			if(Report.bModified && !bDryRun)
+			{
+				Report.bSaved = SavePackage(Sequence->GetPackage(), Report.Error);
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("AudioAnimationNotify : %s, %d footsteps, %d foley movements%s"), *Report.PackageName, Report.NumFootsteps, Report.NumFoleyMovements,
+				!Report.Error.IsEmpty() ? *FString::Printf(TEXT(", %s"), *Report.Error) : Report.bSaved ? TEXT(", saved") : TEXT(""));
+		}
+
+		CollectGarbage(RF_NoFlags);
+	}
+
+	int NumModified = 0;
+	int NumSaved = 0;
+	int NumFailed = 0;
+	int NumFootsteps = 0;
+	int NumFoleyMovements = 0;
+	for (const FSequenceReport& Report : Reports)
+	{
+		NumModified += Report.bModified ? 1 : 0;
+		NumSaved += Report.bSaved ? 1 : 0;
+		NumFailed += Report.Error.IsEmpty() ? 0 : 1;
+		NumFootsteps += Report.NumFootsteps;
+		NumFoleyMovements += Report.NumFoleyMovements;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("AudioAnimationNotify : %d sequences, %d modified, %d saved, %d failed. %d footstep and %d foley notifies."),
+		Reports.Num(), NumModified, NumSaved, NumFailed, NumFootsteps, NumFoleyMovements);
+
+	FString ReportFile;
+	if(FParse::Value(*Params, TEXT("Report="), ReportFile))
+	{
+		WriteReport(ReportFile, Reports);
+	}
+
+	return NumFailed > 0 ? 1 : 0;
+}
+
+FAudioAnimationAnalysisSettings UAudioAnimationNotifyCommandlet::ParseSettings(const FString& Params)
+{
+	FAudioAnimationAnalysisSettings Settings;
+
+	FString Method;
+	if(FParse::Value(*Params, TEXT("Method="), Method))
+	{
+		if(Method == TEXT("TangentCalculation"))
+		{
+			Settings.FootstepDetectionMethod = TangentCalculation;
+		}
+		else if(Method != TEXT("HeightThreshold"))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("AudioAnimationNotify : unknown method %s, using HeightThreshold"), *Method);
+		}
+	}
+
+	FParse::Value(*Params, TEXT("GroundContactStartThreshold="), Settings.GroundContactStartThreshold);
+	FParse::Value(*Params, TEXT("GroundContactStopMargin="), Settings.GroundContactStopMargin);
+	FParse::Value(*Params, TEXT("FootstepSpeedThreshold="), Settings.FootstepSpeedThreshold);
+	FParse::Value(*Params, TEXT("FootstepSpeedCalculationWindow="), Settings.FootstepSpeedCalculationWindow);
+	FParse::Value(*Params, TEXT("FootstepDetectionSensitivity="), Settings.FootstepDetectionSensitivity);
+	FParse::Value(*Params, TEXT("AnimationEdgesMargin="), Settings.AnimationEdgesMargin);
+	FParse::Value(*Params, TEXT("FoleySpeedThreshold="), Settings.FoleySpeedThreshold);
+	FParse::Value(*Params, TEXT("FoleyMinimumMovementDuration="), Settings.FoleyMinimumMovementDuration);
+	Settings.VerboseLogging = FParse::Param(*Params, TEXT("VerboseLogging"));
+	Settings.UseAnalysisCache = !FParse::Param(*Params, TEXT("NoCache"));
+
+	return Settings;
+}
+
+FFootstepOutputSettings UAudioAnimationNotifyCommandlet::ParseFootstepOutput(const FString& Params, const bool bHasNotifyClass)
+{
+	FFootstepOutputSettings Output;
+	Output.WriteNotifies = bHasNotifyClass;
+
+	//-SyncMarkers=foot_l:L,foot_r:R
+	FString SyncMarkersValue;
+	if(FParse::Value(*Params, TEXT("SyncMarkers="), SyncMarkersValue, false))
+	{
+		Output.WriteSyncMarkers = true;
+		Output.SyncMarkerNames.Empty();
+
+		TArray<FString> Pairs;
+		SyncMarkersValue.ParseIntoArray(Pairs, TEXT(","));
+		for (const FString& Pair : Pairs)
+		{
+			FString Bone;
+			FString Marker;
+			if(Pair.Split(TEXT(":"), &Bone, &Marker))
+			{
+				Output.SyncMarkerNames.Add(FName(*Bone), FName(*Marker));
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("AudioAnimationNotify : sync marker %s is not Bone:Marker, ignored"), *Pair);
+			}
+		}
+	}
+
+	//-ContactCurves, or -ContactCurves=Prefix
+	FString ContactCurvePrefix;
+	if(FParse::Value(*Params, TEXT("ContactCurves="), ContactCurvePrefix))
+	{
+		Output.WriteContactCurves = true;
+		Output.ContactCurvePrefix = ContactCurvePrefix;
+	}
+	else if(FParse::Param(*Params, TEXT("ContactCurves")))
+	{
+		Output.WriteContactCurves = true;
+	}
+
+	Output.WriteTimingData = FParse::Param(*Params, TEXT("TimingData"));
+
+	return Output;
+}
+
+TSubclassOf<UAnimNotify> UAudioAnimationNotifyCommandlet::LoadNotifyClass(const FString& Params, const TCHAR* Switch)
+{
+	FString ClassPath;
+	if(!FParse::Value(*Params, Switch, ClassPath))
+	{
+		return nullptr;
+	}
+
+	UClass* NotifyClass = LoadClass<UAnimNotify>(nullptr, *ClassPath);
+	if(NotifyClass == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationNotify : cannot load notify class %s"), *ClassPath);
+	}
+
+	return NotifyClass;
+}
+
+bool UAudioAnimationNotifyCommandlet::SavePackage(UPackage* Package, FString& OutError)
+{
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+	//Check out is left to the pipeline
+	if(IFileManager::Get().IsReadOnly(*Filename))
+	{
+		OutError = TEXT("Read only, not saved");
+		return false;
+	}
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if(!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+	{
+		OutError = TEXT("Failed to save");
+		return false;
+	}
+
+	return true;
+}
+
+void UAudioAnimationNotifyCommandlet::WriteReport(const FString& ReportFile, const TArray<FSequenceReport>& Reports)
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Reports.Num() + 1);
+	Lines.Add(TEXT("Package,Footsteps,Foley,Modified,Saved,Error"));
+
+	for (const FSequenceReport& Report : Reports)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%d,%d,%d,%d,%s"), *Report.PackageName, Report.NumFootsteps, Report.NumFoleyMovements,
+			Report.bModified ? 1 : 0, Report.bSaved ? 1 : 0, *Report.Error));
+	}
+
+	if(!FFileHelper::SaveStringArrayToFile(Lines, *ReportFile))
+	{
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationNotify : cannot write report %s"), *ReportFile);
+	}
+}
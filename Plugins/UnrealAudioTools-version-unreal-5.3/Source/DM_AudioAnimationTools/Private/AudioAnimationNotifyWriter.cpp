@@ -0,0 +1,578 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioAnimationNotifyWriter.h"
+
+#include "DemuteFootstepTimingData.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimCurveTypes.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+
+#if WITH_EDITORONLY_DATA
+
+namespace AudioAnimationNotifyWriter
+{
+	/**Notifies this close in time are the same notify*/
+	static constexpr float NotifyTimeTolerance = 1.e-4f;
+
+	/**
+	 * True if the notify track already holds exactly these notifies, from a previous generation with the same results.
+	 * OutNotifies then holds the existing notifies, in the order of Times.
+	 */
+	static bool HasSameNotifies(const UAnimSequenceBase* AnimationSequence, const FName TrackName, const UClass* AnimNotifyClass, const TArray<float>& Times, TArray<UAnimNotify*>& OutNotifies)
+	{
+		const int TrackIndex = AnimationSequence->AnimNotifyTracks.IndexOfByPredicate([TrackName](const FAnimNotifyTrack& Track){return Track.TrackName == TrackName;});
+		if(TrackIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		TArray<const FAnimNotifyEvent*> TrackNotifies;
+		for (const FAnimNotifyEvent& NotifyEvent : AnimationSequence->Notifies)
+		{
+			if(NotifyEvent.TrackIndex == TrackIndex)
+			{
+				TrackNotifies.Add(&NotifyEvent);
+			}
+		}
+
+		if(TrackNotifies.Num() != Times.Num())
+		{
+			return false;
+		}
+
+		TrackNotifies.Sort([](const FAnimNotifyEvent& A, const FAnimNotifyEvent& B){return A.GetTime() < B.GetTime();});
+
+		OutNotifies.Reset();
+		for (int NotifyIndex = 0; NotifyIndex < TrackNotifies.Num(); NotifyIndex++)
+		{
+			UAnimNotify* Notify = TrackNotifies[NotifyIndex]->Notify;
+			if(Notify == nullptr || Notify->GetClass() != AnimNotifyClass ||
+				!FMath::IsNearlyEqual(TrackNotifies[NotifyIndex]->GetTime(), Times[NotifyIndex], NotifyTimeTolerance))
+			{
+				return false;
+			}
+
+			OutNotifies.Add(Notify);
+		}
+
+		return true;
+	}
+
+	/**Footsteps of the track kept by the sensitivity, and by the animation edges margin if FilterEdges*/
+	static void GetKeptFootsteps(const UAnimSequenceBase* AnimationSequence, const FFootstepAudioTrack& FootstepAudioTrack, const FAudioAnimationAnalysisSettings& Settings,
+		const bool FilterEdges, TArray<const FFootstepAudioData*>& OutFootsteps)
+	{
+		//Sensitivity calculation
+		const float MinimumSpeed = FootstepAudioTrack.FastestBoneSpeed*(1-Settings.FootstepDetectionSensitivity);
+
+		for (const FFootstepAudioData& FootstepAudioData : FootstepAudioTrack.Footsteps)
+		{
+			//Sensitivity filtering
+			if(FootstepAudioData.FootstepSpeed <= MinimumSpeed) continue;
+			//Filter out events on animation edges
+			if(FilterEdges && (FootstepAudioData.FootstepTime <= Settings.AnimationEdgesMargin ||
+				FootstepAudioData.FootstepTime >= AnimationSequence->GetPlayLength() - Settings.AnimationEdgesMargin)) continue;
+
+			OutFootsteps.Add(&FootstepAudioData);
+		}
+	}
+}
+
+#endif
+
+bool FAudioAnimationNotifyWriter::WriteFootstepNotifies(UAnimSequenceBase* AnimationSequence, TArray<FFootstepAudioTrack>& FootstepTracks,
+	TSubclassOf<UAnimNotify> AnimNotifyClass, const FAudioAnimationAnalysisSettings& Settings, TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies)
+{
+	bool WasAnimationFileModified = false;
+
+#if WITH_EDITORONLY_DATA
+
+	if(AnimationSequence == nullptr)
+	{
+		return false;
+	}
+
+	for (FFootstepAudioTrack& FootstepAudioTrack : FootstepTracks)
+	{
+		TArray<const FFootstepAudioData*> Footsteps;
+		AudioAnimationNotifyWriter::GetKeptFootsteps(AnimationSequence, FootstepAudioTrack, Settings, true, Footsteps);
+
+		TArray<float> FootstepTimes;
+		for (const FFootstepAudioData* FootstepAudioData : Footsteps)
+		{
+			FootstepTimes.Add(FootstepAudioData->FootstepTime);
+		}
+
+		//Same notifies as the previous generation: keep them, so the animation isn't dirtied
+		TArray<UAnimNotify*> ExistingNotifies;
+		if(AudioAnimationNotifyWriter::HasSameNotifies(AnimationSequence, FootstepAudioTrack.TrackName, AnimNotifyClass, FootstepTimes, ExistingNotifies))
+		{
+			for (int FootstepIndex = 0; FootstepIndex < Footsteps.Num(); FootstepIndex++)
+			{
+				CreatedNotifies.Add(ExistingNotifies[FootstepIndex], *Footsteps[FootstepIndex]);
+			}
+			continue;
+		}
+
+		int NewNotifyTrackIndex = AnimationSequence->AnimNotifyTracks.Num();
+
+		//If a track already exists with same name clear it (suppose previous generation)
+		for (int TrackId = 0; TrackId < AnimationSequence->AnimNotifyTracks.Num(); TrackId++)
+		{
+			if(AnimationSequence->AnimNotifyTracks[TrackId].TrackName == FootstepAudioTrack.TrackName)
+			{
+				AnimationSequence->Notifies.RemoveAll([TrackId](const FAnimNotifyEvent& NotifyEvent){return NotifyEvent.TrackIndex == TrackId;});
+				NewNotifyTrackIndex = TrackId;
+				WasAnimationFileModified = true;
+			}
+		}
+
+		
+		if(AnimationSequence->AnimNotifyTracks.Num() <= NewNotifyTrackIndex)
+		{
+			AnimationSequence->AnimNotifyTracks.SetNum(NewNotifyTrackIndex + 1);
+			AnimationSequence->AnimNotifyTracks[NewNotifyTrackIndex].TrackName = FootstepAudioTrack.TrackName;
+			WasAnimationFileModified = true;
+		}
+		
+		for (const FFootstepAudioData* FootstepAudioData : Footsteps)
+		{
+			FAnimNotifyEvent NewNotifyEvent;
+			NewNotifyEvent.NotifyName = "AutoTag_Footstep";
+			UAnimNotify* Notify = NewObject<UAnimNotify>(AnimationSequence, AnimNotifyClass);
+			NewNotifyEvent.Notify = Notify;
+			NewNotifyEvent.Link(AnimationSequence, FootstepAudioData->FootstepTime); //Links montage notifies to their segment
+			NewNotifyEvent.TrackIndex = NewNotifyTrackIndex;
+
+			AnimationSequence->Notifies.Add(NewNotifyEvent);
+			CreatedNotifies.Add(Notify, *FootstepAudioData);
+			
+			WasAnimationFileModified = true;
+		}
+	}
+
+	if(WasAnimationFileModified)
+	{
+		AnimationSequence->Modify(true);
+		AnimationSequence->RefreshCacheData();
+	}
+	
+#endif
+
+	return WasAnimationFileModified;
+}
+
+bool FAudioAnimationNotifyWriter::WriteFootsteps(UAnimSequence* AnimationSequence, TArray<FFootstepAudioTrack>& FootstepTracks, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	const FAudioAnimationAnalysisSettings& Settings, const FFootstepOutputSettings& OutputSettings, TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies)
+{
+	bool WasAnimationFileModified = false;
+
+	if(OutputSettings.WriteNotifies)
+	{
+		WasAnimationFileModified |= WriteFootstepNotifies(AnimationSequence, FootstepTracks, AnimNotifyClass, Settings, CreatedNotifies);
+	}
+
+	if(OutputSettings.WriteSyncMarkers)
+	{
+		WasAnimationFileModified |= WriteFootstepSyncMarkers(AnimationSequence, FootstepTracks, Settings, OutputSettings.SyncMarkerNames);
+	}
+
+	if(OutputSettings.WriteContactCurves)
+	{
+		WasAnimationFileModified |= WriteFootstepContactCurves(AnimationSequence, FootstepTracks, OutputSettings.ContactCurvePrefix);
+	}
+
+	if(OutputSettings.WriteTimingData)
+	{
+		WasAnimationFileModified |= WriteFootstepTimingData(AnimationSequence, FootstepTracks, Settings);
+	}
+
+	return WasAnimationFileModified;
+}
+
+bool FAudioAnimationNotifyWriter::WriteFootstepSyncMarkers(UAnimSequence* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	const FAudioAnimationAnalysisSettings& Settings, const TMap<FName, FName>& SyncMarkerNames)
+{
+#if WITH_EDITORONLY_DATA
+
+	if(AnimationSequence == nullptr)
+	{
+		return false;
+	}
+
+	const FName SyncMarkerTrackName = TEXT("AutoGen Sync Markers");
+
+	//Markers of all feet, on a single track
+	TArray<TPair<float, FName>> NewMarkers;
+	GetFootstepSyncMarkers(AnimationSequence, FootstepTracks, Settings, SyncMarkerNames, NewMarkers);
+
+	int SyncMarkerTrackIndex = AnimationSequence->AnimNotifyTracks.IndexOfByPredicate([SyncMarkerTrackName](const FAnimNotifyTrack& Track){return Track.TrackName == SyncMarkerTrackName;});
+
+	//Same markers as the previous generation: the animation isn't dirtied
+	if(SyncMarkerTrackIndex != INDEX_NONE)
+	{
+		TArray<const FAnimSyncMarker*> ExistingMarkers;
+		for (const FAnimSyncMarker& SyncMarker : AnimationSequence->AuthoredSyncMarkers)
+		{
+			if(SyncMarker.TrackIndex == SyncMarkerTrackIndex)
+			{
+				ExistingMarkers.Add(&SyncMarker);
+			}
+		}
+		ExistingMarkers.Sort([](const FAnimSyncMarker& A, const FAnimSyncMarker& B){return A.Time < B.Time;});
+
+		bool SameMarkers = ExistingMarkers.Num() == NewMarkers.Num();
+		for (int MarkerIndex = 0; SameMarkers && MarkerIndex < NewMarkers.Num(); MarkerIndex++)
+		{
+			SameMarkers = ExistingMarkers[MarkerIndex]->MarkerName == NewMarkers[MarkerIndex].Value &&
+				FMath::IsNearlyEqual(ExistingMarkers[MarkerIndex]->Time, NewMarkers[MarkerIndex].Key, AudioAnimationNotifyWriter::NotifyTimeTolerance);
+		}
+
+		if(SameMarkers)
+		{
+			return false;
+		}
+
+		AnimationSequence->AuthoredSyncMarkers.RemoveAll([SyncMarkerTrackIndex](const FAnimSyncMarker& SyncMarker){return SyncMarker.TrackIndex == SyncMarkerTrackIndex;});
+	}
+	else
+	{
+		SyncMarkerTrackIndex = AnimationSequence->AnimNotifyTracks.Num();
+		AnimationSequence->AnimNotifyTracks.AddDefaulted_GetRef().TrackName = SyncMarkerTrackName;
+	}
+
+	for (const TPair<float, FName>& NewMarker : NewMarkers)
+	{
+		FAnimSyncMarker& SyncMarker = AnimationSequence->AuthoredSyncMarkers.AddDefaulted_GetRef();
+		SyncMarker.MarkerName = NewMarker.Value;
+		SyncMarker.Time = NewMarker.Key;
+		SyncMarker.TrackIndex = SyncMarkerTrackIndex;
+		SyncMarker.Guid = FGuid::NewGuid();
+	}
+
+	AnimationSequence->Modify(true);
+	AnimationSequence->RefreshSyncMarkerDataFromAuthored();
+	AnimationSequence->RefreshCacheData();
+
+	return true;
+
+#else
+
+	return false;
+
+#endif
+}
+
+void FAudioAnimationNotifyWriter::GetFootstepSyncMarkers(const UAnimSequenceBase* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	const FAudioAnimationAnalysisSettings& Settings, const TMap<FName, FName>& SyncMarkerNames, TArray<TPair<float, FName>>& OutMarkers)
+{
+	OutMarkers.Reset();
+
+#if WITH_EDITORONLY_DATA
+
+	//Edges are kept: a contact on the loop point still is a sync point
+	for (const FFootstepAudioTrack& FootstepAudioTrack : FootstepTracks)
+	{
+		TArray<const FFootstepAudioData*> Footsteps;
+		AudioAnimationNotifyWriter::GetKeptFootsteps(AnimationSequence, FootstepAudioTrack, Settings, false, Footsteps);
+
+		for (const FFootstepAudioData* FootstepAudioData : Footsteps)
+		{
+			if(const FName* MarkerName = SyncMarkerNames.Find(FootstepAudioData->BoneName))
+			{
+				OutMarkers.Emplace(FootstepAudioData->FootstepTime, *MarkerName);
+			}
+		}
+	}
+	OutMarkers.Sort([](const TPair<float, FName>& A, const TPair<float, FName>& B){return A.Key < B.Key;});
+
+#endif
+}
+
+bool FAudioAnimationNotifyWriter::HaveConsistentSyncMarkers(TConstArrayView<const UAnimSequence*> Sequences, TConstArrayView<TArray<FFootstepAudioTrack>> SequenceFootstepTracks,
+	const FAudioAnimationAnalysisSettings& Settings, const TMap<FName, FName>& SyncMarkerNames, const FString& Context)
+{
+	//Markers of each sequence over its cycle, in time order
+	TArray<TArray<TPair<float, FName>>> SequenceMarkers;
+	for (int SequenceIndex = 0; SequenceIndex < Sequences.Num(); SequenceIndex++)
+	{
+		TArray<TPair<float, FName>>& Markers = SequenceMarkers.AddDefaulted_GetRef();
+		if(Sequences[SequenceIndex] != nullptr)
+		{
+			GetFootstepSyncMarkers(Sequences[SequenceIndex], SequenceFootstepTracks[SequenceIndex], Settings, SyncMarkerNames, Markers);
+		}
+	}
+
+	bool Consistent = true;
+	for (int SequenceIndex = 1; SequenceIndex < Sequences.Num(); SequenceIndex++)
+	{
+		const TArray<TPair<float, FName>>& Reference = SequenceMarkers[0];
+		const TArray<TPair<float, FName>>& Markers = SequenceMarkers[SequenceIndex];
+
+		//Cycles may start on another foot: the order only has to match up to a rotation
+		bool SameOrder = false;
+		for (int Rotation = 0; Rotation < FMath::Max(Markers.Num(), 1) && !SameOrder && Markers.Num() == Reference.Num(); Rotation++)
+		{
+			SameOrder = true;
+			for (int MarkerIndex = 0; MarkerIndex < Markers.Num() && SameOrder; MarkerIndex++)
+			{
+				SameOrder = Markers[(MarkerIndex + Rotation) % Markers.Num()].Value == Reference[MarkerIndex].Value;
+			}
+		}
+
+		if(!SameOrder)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("AudioAnimationTools -- %s : %s has %d sync markers, in another order than the %d of %s. They won't line up when blended."),
+				*Context, *GetNameSafe(Sequences[SequenceIndex]), Markers.Num(), Reference.Num(), *GetNameSafe(Sequences[0]));
+			Consistent = false;
+		}
+	}
+
+	return Consistent;
+}
+
+bool FAudioAnimationNotifyWriter::WriteFootstepContactCurves(UAnimSequence* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	const FString& ContactCurvePrefix)
+{
+	bool WasAnimationFileModified = false;
+
+#if WITH_EDITOR
+
+	if(AnimationSequence == nullptr || AnimationSequence->GetDataModel() == nullptr)
+	{
+		return false;
+	}
+
+	IAnimationDataController& Controller = AnimationSequence->GetController();
+
+	for (const FFootstepAudioTrack& FootstepAudioTrack : FootstepTracks)
+	{
+		//A foot never touching the ground would be flat anyway
+		if(FootstepAudioTrack.GroundContacts.Num() == 0)
+		{
+			continue;
+		}
+
+		//Constant keys: 1 from each contact, 0 once the foot leaves the ground. A foot planted at the start is 1 from the first key.
+		TArray<FRichCurveKey> Keys;
+		Keys.Emplace(0.0f, 0.0f);
+		for (const FFootContactInterval& Contact : FootstepAudioTrack.GroundContacts)
+		{
+			if(Contact.StartTime <= Keys.Last().Time)
+			{
+				Keys.Last().Value = 1.0f;
+			}
+			else
+			{
+				Keys.Emplace(Contact.StartTime, 1.0f);
+			}
+
+			//Still on the ground at the end: no key, looping animations stay planted across the loop point
+			if(Contact.EndTime > Keys.Last().Time && Contact.EndTime < AnimationSequence->GetPlayLength())
+			{
+				Keys.Emplace(Contact.EndTime, 0.0f);
+			}
+		}
+
+		for (FRichCurveKey& Key : Keys)
+		{
+			Key.InterpMode = RCIM_Constant;
+		}
+
+		const FAnimationCurveIdentifier CurveId(FName(ContactCurvePrefix + FootstepAudioTrack.BoneName.ToString()), ERawCurveTrackTypes::RCT_Float);
+		const FFloatCurve* ExistingCurve = AnimationSequence->GetDataModel()->FindFloatCurve(CurveId);
+
+		//Same curve as the previous generation: the animation isn't dirtied
+		if(ExistingCurve != nullptr)
+		{
+			const TArray<FRichCurveKey>& ExistingKeys = ExistingCurve->FloatCurve.GetConstRefOfKeys();
+
+			bool SameKeys = ExistingKeys.Num() == Keys.Num();
+			for (int KeyIndex = 0; SameKeys && KeyIndex < Keys.Num(); KeyIndex++)
+			{
+				SameKeys = ExistingKeys[KeyIndex].Value == Keys[KeyIndex].Value && ExistingKeys[KeyIndex].InterpMode == RCIM_Constant &&
+					FMath::IsNearlyEqual(ExistingKeys[KeyIndex].Time, Keys[KeyIndex].Time, AudioAnimationNotifyWriter::NotifyTimeTolerance);
+			}
+
+			if(SameKeys)
+			{
+				continue;
+			}
+		}
+		else
+		{
+			Controller.AddCurve(CurveId);
+		}
+
+		//The controller transacts and dirties the animation itself
+		Controller.SetCurveKeys(CurveId, Keys);
+		WasAnimationFileModified = true;
+	}
+
+#endif
+
+	return WasAnimationFileModified;
+}
+
+bool FAudioAnimationNotifyWriter::WriteFootstepTimingData(UAnimSequenceBase* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	const FAudioAnimationAnalysisSettings& Settings)
+{
+#if WITH_EDITORONLY_DATA
+
+	if(AnimationSequence == nullptr || AnimationSequence->GetPlayLength() <= 0.0f)
+	{
+		return false;
+	}
+
+	const float PlayLength = AnimationSequence->GetPlayLength();
+
+	//Intensities are relative to the fastest footstep of all feet
+	float FastestSpeed = 0.0f;
+	for (const FFootstepAudioTrack& FootstepAudioTrack : FootstepTracks)
+	{
+		FastestSpeed = FMath::Max(FastestSpeed, FootstepAudioTrack.FastestBoneSpeed);
+	}
+
+	//Same footsteps as the notifies, so runtime lookahead and notifies agree
+	TArray<FDemuteFootstepContact> NewContacts;
+	for (const FFootstepAudioTrack& FootstepAudioTrack : FootstepTracks)
+	{
+		TArray<const FFootstepAudioData*> Footsteps;
+		AudioAnimationNotifyWriter::GetKeptFootsteps(AnimationSequence, FootstepAudioTrack, Settings, true, Footsteps);
+
+		for (const FFootstepAudioData* FootstepAudioData : Footsteps)
+		{
+			FDemuteFootstepContact& Contact = NewContacts.AddDefaulted_GetRef();
+			Contact.Phase = FMath::Clamp(FootstepAudioData->FootstepTime / PlayLength, 0.0f, 1.0f);
+			Contact.Foot = FootstepAudioData->BoneName;
+			Contact.Intensity = FastestSpeed > 0.0f ? FMath::Clamp(FootstepAudioData->FootstepSpeed / FastestSpeed, 0.0f, 1.0f) : 1.0f;
+		}
+	}
+	NewContacts.Sort([](const FDemuteFootstepContact& A, const FDemuteFootstepContact& B){return A.Phase < B.Phase;});
+
+	UDemuteFootstepTimingData* TimingData = UDemuteFootstepTimingData::Find(AnimationSequence);
+
+	//Same contacts as the previous generation: the animation isn't dirtied
+	if(TimingData != nullptr && FMath::IsNearlyEqual(TimingData->PlayLength, PlayLength, AudioAnimationNotifyWriter::NotifyTimeTolerance) &&
+		TimingData->Contacts.Num() == NewContacts.Num())
+	{
+		bool SameContacts = true;
+		for (int ContactIndex = 0; SameContacts && ContactIndex < NewContacts.Num(); ContactIndex++)
+		{
+			const FDemuteFootstepContact& ExistingContact = TimingData->Contacts[ContactIndex];
+			SameContacts = ExistingContact.Foot == NewContacts[ContactIndex].Foot &&
+				FMath::IsNearlyEqual(ExistingContact.Phase * PlayLength, NewContacts[ContactIndex].Phase * PlayLength, AudioAnimationNotifyWriter::NotifyTimeTolerance) &&
+				FMath::IsNearlyEqual(ExistingContact.Intensity, NewContacts[ContactIndex].Intensity, 1.e-3f);
+		}
+
+		if(SameContacts)
+		{
+			return false;
+		}
+	}
+
+	AnimationSequence->Modify(true);
+
+	if(TimingData == nullptr)
+	{
+		TimingData = NewObject<UDemuteFootstepTimingData>(AnimationSequence, NAME_None, RF_Transactional);
+		AnimationSequence->AddAssetUserData(TimingData);
+	}
+	else
+	{
+		TimingData->Modify();
+	}
+
+	TimingData->PlayLength = PlayLength;
+	TimingData->Contacts = MoveTemp(NewContacts);
+
+	return true;
+
+#else
+
+	return false;
+
+#endif
+}
+
+bool FAudioAnimationNotifyWriter::WriteFoleyNotifies(UAnimSequenceBase* AnimationSequence, TArray<FFoleyAudioTrack>& FoleyTracks,
+	TSubclassOf<UAnimNotify> AnimNotifyClass, TMap<UAnimNotify*, FFoleyAudioData>& CreatedNotifies)
+{
+	bool WasAnimationFileModified = false;
+
+#if WITH_EDITORONLY_DATA
+
+	if(AnimationSequence == nullptr)
+	{
+		return false;
+	}
+
+	for (FFoleyAudioTrack& FoleyAudioTrack : FoleyTracks)
+	{
+		TArray<float> FoleyTimes;
+		for (const FFoleyAudioData& FoleyAudioData : FoleyAudioTrack.FoleyMovements)
+		{
+			FoleyTimes.Add(FoleyAudioData.FoleyTime);
+		}
+
+		//Same notifies as the previous generation: keep them, so the animation isn't dirtied
+		TArray<UAnimNotify*> ExistingNotifies;
+		if(AudioAnimationNotifyWriter::HasSameNotifies(AnimationSequence, FoleyAudioTrack.TrackName, AnimNotifyClass, FoleyTimes, ExistingNotifies))
+		{
+			for (int MovementIndex = 0; MovementIndex < FoleyAudioTrack.FoleyMovements.Num(); MovementIndex++)
+			{
+				CreatedNotifies.Add(ExistingNotifies[MovementIndex], FoleyAudioTrack.FoleyMovements[MovementIndex]);
+			}
+			continue;
+		}
+
+		int NewNotifyTrackIndex = AnimationSequence->AnimNotifyTracks.Num();
+
+		//If a track already exists with same name clear it (suppose previous generation)
+		for (int TrackId = 0; TrackId < AnimationSequence->AnimNotifyTracks.Num(); TrackId++)
+		{
+			if(AnimationSequence->AnimNotifyTracks[TrackId].TrackName == FoleyAudioTrack.TrackName)
+			{
+				AnimationSequence->Notifies.RemoveAll([TrackId](const FAnimNotifyEvent& NotifyEvent){return NotifyEvent.TrackIndex == TrackId;});
+				NewNotifyTrackIndex = TrackId;
+				WasAnimationFileModified = true;
+			}
+		}
+
+		if(AnimationSequence->AnimNotifyTracks.Num() <= NewNotifyTrackIndex)
+		{
+			AnimationSequence->AnimNotifyTracks.SetNum(NewNotifyTrackIndex + 1);
+			AnimationSequence->AnimNotifyTracks[NewNotifyTrackIndex].TrackName = FoleyAudioTrack.TrackName;
+			WasAnimationFileModified = true;
+		}
+
+
+		for (FFoleyAudioData& FoleyAudioData : FoleyAudioTrack.FoleyMovements)
+		{
+			FAnimNotifyEvent NewNotifyEvent;
+			NewNotifyEvent.NotifyName = "AutoTag_Foley";
+			UAnimNotify* Notify = NewObject<UAnimNotify>(AnimationSequence, AnimNotifyClass);
+			NewNotifyEvent.Notify = Notify;
+			NewNotifyEvent.Link(AnimationSequence, FoleyAudioData.FoleyTime);
+			NewNotifyEvent.TrackIndex = NewNotifyTrackIndex;
+			
+			AnimationSequence->Notifies.Add(NewNotifyEvent);
+			CreatedNotifies.Add(Notify, FoleyAudioData);
+			
+			WasAnimationFileModified = true;
+		}
+	}
+
+	if(WasAnimationFileModified)
+	{
+		AnimationSequence->Modify(true);
+		AnimationSequence->RefreshCacheData();
+	}
+	
+#endif
+
+	return WasAnimationFileModified;
+}
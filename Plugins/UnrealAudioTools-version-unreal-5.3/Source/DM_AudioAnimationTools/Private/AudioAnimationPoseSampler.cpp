@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioAnimationPoseSampler.h"
+
+#include "AudioAnimationTrajectory.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimationPoseData.h"
+#include "Animation/AttributesRuntime.h"
+#include "BonePose.h"
+
+FAudioAnimationPoseSampler::FAudioAnimationPoseSampler(const UAnimSequence* InAnimSequence, const TArray<int>& BoneIndexes)
+{
+	USkeleton* Skeleton = InAnimSequence ? InAnimSequence->GetSkeleton() : nullptr;
+	if(Skeleton == nullptr)
+	{
+		return;
+	}
+
+	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+
+	//Requested bones and all their ancestors, parents first as the bone container expects
+	TBitArray<> RequiredBones(false, ReferenceSkeleton.GetNum());
+	for (const int BoneIndex : BoneIndexes)
+	{
+		for (int CurrentBoneIndex = BoneIndex; CurrentBoneIndex != INDEX_NONE && !RequiredBones[CurrentBoneIndex]; CurrentBoneIndex = ReferenceSkeleton.GetParentIndex(CurrentBoneIndex))
+		{
+			RequiredBones[CurrentBoneIndex] = true;
+		}
+	}
+
+	TArray<FBoneIndexType> RequiredBoneIndexes;
+	for (TConstSetBitIterator<> It(RequiredBones); It; ++It)
+	{
+		RequiredBoneIndexes.Add(static_cast<FBoneIndexType>(It.GetIndex()));
+	}
+
+	BoneContainer.InitializeTo(RequiredBoneIndexes, UE::Anim::FCurveFilterSettings(UE::Anim::ECurveFilterMode::DisallowAll), *Skeleton);
+
+	RequestedCompactIndexes.Reserve(BoneIndexes.Num());
+	for (const int BoneIndex : BoneIndexes)
+	{
+		RequestedCompactIndexes.Add(BoneContainer.GetCompactPoseIndexFromSkeletonIndex(BoneIndex));
+	}
+
+	ComponentSpaceTransforms.SetNum(RequiredBoneIndexes.Num());
+	AnimSequence = InAnimSequence;
+}
+
+void FAudioAnimationPoseSampler::Evaluate(const double Time)
+{
+	if(!IsValid())
+	{
+		return;
+	}
+
+	//Pose buffers live on the anim stack for the duration of the evaluation only
+	FMemMark Mark(FMemStack::Get());
+
+	FCompactPose Pose;
+	Pose.SetBoneContainer(&BoneContainer);
+
+	FBlendedCurve Curve;
+	Curve.InitFrom(BoneContainer);
+
+	UE::Anim::FStackAttributeContainer Attributes;
+
+	FAnimationPoseData PoseData(Pose, Curve, Attributes);
+	AnimSequence->GetAnimationPose(PoseData, FAnimExtractContext(Time, false));
+
+	//Parents always come before their children in a compact pose
+	for (const FCompactPoseBoneIndex BoneIndex : Pose.ForEachBoneIndex())
+	{
+		const FCompactPoseBoneIndex ParentIndex = BoneContainer.GetParentBoneIndex(BoneIndex);
+		ComponentSpaceTransforms[BoneIndex.GetInt()] = ParentIndex.GetInt() == INDEX_NONE
+			? Pose[BoneIndex]
+			: Pose[BoneIndex] * ComponentSpaceTransforms[ParentIndex.GetInt()];
+	}
+}
+
+FVector FAudioAnimationPoseSampler::GetBoneLocation(const int RequestedBone) const
+{
+	if(!RequestedCompactIndexes.IsValidIndex(RequestedBone) || RequestedCompactIndexes[RequestedBone].GetInt() == INDEX_NONE)
+	{
+		return FVector::ZeroVector;
+	}
+
+	return ComponentSpaceTransforms[RequestedCompactIndexes[RequestedBone].GetInt()].GetLocation();
+}
+
+void FAudioAnimationPoseSampler::SampleBoneTrajectories(TConstArrayView<float> Times, FAudioAnimationTrajectories& OutTrajectories)
+{
+	OutTrajectories.Init(Times, RequestedCompactIndexes.Num());
+
+	for (int TimeIndex = 0; TimeIndex < Times.Num(); TimeIndex++)
+	{
+		Evaluate(Times[TimeIndex]);
+
+		for (int RequestedBone = 0; RequestedBone < RequestedCompactIndexes.Num(); RequestedBone++)
+		{
+			const FVector BoneLocation = GetBoneLocation(RequestedBone);
+			OutTrajectories.X[RequestedBone][TimeIndex] = BoneLocation.X;
+			OutTrajectories.Y[RequestedBone][TimeIndex] = BoneLocation.Y;
+			OutTrajectories.Z[RequestedBone][TimeIndex] = BoneLocation.Z;
+		}
+	}
+}
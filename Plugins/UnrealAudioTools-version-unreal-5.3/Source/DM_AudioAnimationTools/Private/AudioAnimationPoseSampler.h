@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneContainer.h"
+
+struct FAudioAnimationTrajectories;
+class UAnimSequence;
+
+/**
+ * Evaluates the component space locations of a set of bones of an animation sequence.
+ *
+ * Each Evaluate decompresses the whole pose once, for the requested bones and their ancestors,
+ * and builds their component space transforms in a single pass from the root.
+ * All requested bones share that buffer, instead of evaluating their parent chain one bone at a time.
+ */
+class FAudioAnimationPoseSampler
+{
+public:
+	/** BoneIndexes are reference skeleton indexes of the bones to sample */
+	FAudioAnimationPoseSampler(const UAnimSequence* InAnimSequence, const TArray<int>& BoneIndexes);
+
+	/** False if the sequence or its skeleton is missing */
+	bool IsValid() const { return AnimSequence != nullptr && BoneContainer.IsValid(); }
+
+	/** Evaluates the pose at Time. Locations are read with GetBoneLocation until the next call. */
+	void Evaluate(double Time);
+
+	/** Component space location of a bone, by its position in the BoneIndexes passed to the constructor */
+	FVector GetBoneLocation(int RequestedBone) const;
+
+	/** Evaluates the pose at every time and fills the trajectories of all requested bones */
+	void SampleBoneTrajectories(TConstArrayView<float> Times, FAudioAnimationTrajectories& OutTrajectories);
+
+private:
+	const UAnimSequence* AnimSequence = nullptr;
+
+	FBoneContainer BoneContainer;
+
+	/** Compact pose index of each requested bone */
+	TArray<FCompactPoseBoneIndex> RequestedCompactIndexes;
+
+	/** Component space transforms of the last evaluation, by compact pose index */
+	TArray<FTransform> ComponentSpaceTransforms;
+};
@@ -3,83 +3,74 @@
 
 #include "AudioAnimationToolsWidget.h"
 
+#include "AudioAnimationAnalyzer.h"
+#include "AudioAnimationNotifyWriter.h"
 #include "Animation/AnimNotifies/AnimNotify.h"
+#include "Animation/BlendSpace.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Tasks/Task.h"
 
-void UAudioAnimationToolsWidget::AutoGenerateFootstepNotifies(UAnimSequence* AnimationSequence, TArray<FName> BoneNames,TSubclassOf<UAnimNotify> AnimNotifyClass,
-                                                              TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies, TArray<FFootstepAudioTrack>& CreatedTracks)
+#define LOCTEXT_NAMESPACE "AudioAnimationToolsWidget"
+
+namespace AudioAnimationToolsBatch
 {
-	CreatedNotifies.Empty();
-	
-	CreatedTracks.Empty();
+	/**
+	 * Runs Analyze for every animation on worker threads, while the game thread shows a cancellable progress dialog.
+	 * OutAnalyzed tells which animations were analyzed. Returns false if cancelled.
+	 */
+	static bool RunParallel(const int NumAnimations, const FText& Message, TFunctionRef<void(int)> Analyze, TArray<bool>& OutAnalyzed)
+	{
+		OutAnalyzed.Init(false, NumAnimations);
 
-	switch (FootstepDetectionMethod) {
-	case HeightThreshold:
-		CalculateFootstepsWithHeightThreshold(AnimationSequence, BoneNames, CreatedTracks);
-		break;
-	case TangentCalculation:
-		CalculateFootstepsWithTangents(AnimationSequence, BoneNames, CreatedTracks);
-		break;
-	}
+		std::atomic<bool> bCancelled = false;
+		std::atomic<int> NumAnalyzed = 0;
 
-#if WITH_EDITORONLY_DATA
+		UE::Tasks::FTask AnalysisTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&]()
+		{
+			ParallelFor(NumAnimations, [&](const int AnimationIndex)
+			{
+				if(bCancelled)
+				{
+					return;
+				}
 
-	bool WasAnimationFileModified = false;
+				Analyze(AnimationIndex);
+				OutAnalyzed[AnimationIndex] = true;
+				++NumAnalyzed;
+			});
+		});
 
-	for (FFootstepAudioTrack& FootstepAudioTrack : CreatedTracks)
-	{
-		int NewNotifyTrackIndex = AnimationSequence->AnimNotifyTracks.Num();
+		FScopedSlowTask SlowTask(NumAnimations, Message);
+		SlowTask.MakeDialog(true);
 
-		//If a track already exists with same name clear it (suppose previous generation)
-		for (int TrackId = 0; TrackId < AnimationSequence->AnimNotifyTracks.Num(); TrackId++)
+		int ReportedAnalyzed = 0;
+		while(!AnalysisTask.Wait(FTimespan::FromMilliseconds(50.0)))
 		{
-			if(AnimationSequence->AnimNotifyTracks[TrackId].TrackName == FootstepAudioTrack.TrackName)
+			const int CurrentAnalyzed = NumAnalyzed;
+			SlowTask.EnterProgressFrame(CurrentAnalyzed - ReportedAnalyzed, FText::Format(LOCTEXT("BatchProgress", "{0} ({1}/{2})"), Message, CurrentAnalyzed, NumAnimations));
+			ReportedAnalyzed = CurrentAnalyzed;
+
+			if(SlowTask.ShouldCancel())
 			{
-				AnimationSequence->Notifies.RemoveAll([TrackId](const FAnimNotifyEvent& NotifyEvent){return NotifyEvent.TrackIndex == TrackId;});
-				NewNotifyTrackIndex = TrackId;
-				WasAnimationFileModified = true;
+				bCancelled = true;
 			}
 		}
 
-		
-		if(AnimationSequence->AnimNotifyTracks.Num() <= NewNotifyTrackIndex)
-		{
-			AnimationSequence->AnimNotifyTracks.SetNum(NewNotifyTrackIndex + 1);
-			AnimationSequence->AnimNotifyTracks[NewNotifyTrackIndex].TrackName = FootstepAudioTrack.TrackName;
-			WasAnimationFileModified = true;
-		}
-		
-		//Sensitivity calculation
-		const float MinimumSpeed = FootstepAudioTrack.FastestBoneSpeed*(1-FootstepDetectionSensitivity);
-		
-		for (FFootstepAudioData& FootstepAudioData : FootstepAudioTrack.Footsteps)
-		{
-			//Sensitivity filtering
-			if(FootstepAudioData.FootstepSpeed <= MinimumSpeed) continue;
-			//Filter out events on animation edges
-			if(FootstepAudioData.FootstepTime <= AnimationEdgesMargin ||
-				FootstepAudioData.FootstepTime >= AnimationSequence->GetPlayLength() - AnimationEdgesMargin) continue;
-			
-			FAnimNotifyEvent NewNotifyEvent;
-			NewNotifyEvent.NotifyName = "AutoTag_Footstep";
-			UAnimNotify* Notify = NewObject<UAnimNotify>(AnimationSequence, AnimNotifyClass);
-			NewNotifyEvent.Notify = Notify;
-			NewNotifyEvent.SetTime(FootstepAudioData.FootstepTime);
-			NewNotifyEvent.TrackIndex = NewNotifyTrackIndex;
-
-			AnimationSequence->Notifies.Add(NewNotifyEvent);
-			CreatedNotifies.Add(Notify, FootstepAudioData);
-			
-			WasAnimationFileModified = true;
-		}
+		return !bCancelled;
 	}
+}
 
-	if(WasAnimationFileModified)
-	{
-		AnimationSequence->Modify(true);
-		AnimationSequence->RefreshCacheData();
-	}
+void UAudioAnimationToolsWidget::AutoGenerateFootstepNotifies(UAnimSequence* AnimationSequence, TArray<FName> BoneNames,TSubclassOf<UAnimNotify> AnimNotifyClass,
+                                                              TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies, TArray<FFootstepAudioTrack>& CreatedTracks)
+{
+	CreatedNotifies.Empty();
 	
-#endif
+	CreatedTracks.Empty();
+
+	FAudioAnimationAnalyzer(GetAnalysisSettings()).AnalyzeFootsteps(AnimationSequence, BoneNames, CreatedTracks);
+
+	FAudioAnimationNotifyWriter::WriteFootsteps(AnimationSequence, CreatedTracks, AnimNotifyClass, GetAnalysisSettings(), FootstepOutput, CreatedNotifies);
 }
 
 void UAudioAnimationToolsWidget::AutoGenerateFoleyNotifies(UAnimSequence* AnimationSequence, TArray<FName> BoneNames,TSubclassOf<UAnimNotify> AnimNotifyClass,
@@ -87,299 +78,179 @@ void UAudioAnimationToolsWidget::AutoGenerateFoleyNotifies(UAnimSequence* Animat
 {
 	CreatedNotifies.Empty();
 
-	if(AnimationSequence == nullptr)
-	{
-		UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- AutoGenerateFoleyNotifies : passed a null AnimSequence. Early exit."));
-		return;
-	}
+	FAudioAnimationAnalyzer(GetAnalysisSettings()).AnalyzeFoley(AnimationSequence, BoneNames, CreatedTracks);
 
-	const USkeleton* Skeleton = AnimationSequence->GetSkeleton();
+	FAudioAnimationNotifyWriter::WriteFoleyNotifies(AnimationSequence, CreatedTracks, AnimNotifyClass, CreatedNotifies);
+}
 
-	if(Skeleton == nullptr)
-	{
-		UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- AutoGenerateFoleyNotifies : AnimSequence had a null skeleton. Early exit."));
-		return;
-	}
+bool UAudioAnimationToolsWidget::AutoGenerateFootstepNotifiesBatch(const TArray<UAnimSequence*>& AnimationSequences, TArray<FName> BoneNames,
+	TSubclassOf<UAnimNotify> AnimNotifyClass, TArray<UAnimSequence*>& ModifiedSequences)
+{
+	ModifiedSequences.Empty();
 
-	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+	TArray<TArray<FFootstepAudioTrack>> AnimationTracks;
+	TArray<bool> Analyzed;
+	const bool bCompleted = AnalyzeFootstepsBatch(AnimationSequences, BoneNames, AnimationTracks, Analyzed);
 
-	TMap<FName, int> BoneIndexesMap;
-	for (FName BoneName : BoneNames)
+	//Notifies are UObjects on the animations: written back here, on the game thread
+	for (int AnimationIndex = 0; AnimationIndex < AnimationSequences.Num(); AnimationIndex++)
 	{
-		const int BoneIndex = ReferenceSkeleton.FindBoneIndex(BoneName);
-		if(BoneIndex != INDEX_NONE)
-		{
-			BoneIndexesMap.Add(BoneName, BoneIndex);
-		}
-		else
+		TMap<UAnimNotify*, FFootstepAudioData> CreatedNotifies;
+		if(Analyzed[AnimationIndex] && FAudioAnimationNotifyWriter::WriteFootsteps(AnimationSequences[AnimationIndex], AnimationTracks[AnimationIndex], AnimNotifyClass, GetAnalysisSettings(), FootstepOutput, CreatedNotifies))
 		{
-			UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- AutoGenerateFoleyNotifies : Bone %s does not exist, skipping it"), *BoneName.ToString());
+			ModifiedSequences.Add(AnimationSequences[AnimationIndex]);
 		}
 	}
-	
-	CreatedTracks.Empty();
-	
-	for (const TTuple<FName, int>& Bone : BoneIndexesMap)
-	{
-		FFoleyAudioTrack& NewFoleyTrack = CreatedTracks.AddDefaulted_GetRef();
-		NewFoleyTrack.TrackName = FName(*("AutoGen " + Bone.Key.ToString()));
 
-		float MovingSinceTime = -1.0f;
-		float PreviousBoneSpeed = 0.0f;
-		FVector PreviousBoneLocation = FVector::ZeroVector;
-		for (float Time = AnimationTimeIncrement; Time < AnimationSequence->GetPlayLength(); Time+=AnimationTimeIncrement)
-		{
-			FVector BoneLocation = GetBoneLocation(AnimationSequence, ReferenceSkeleton, Bone.Value, Time);
-			const float BoneSpeed = ((BoneLocation - PreviousBoneLocation) / AnimationTimeIncrement).Size();
-
-			const bool Moving = BoneSpeed >= FoleySpeedThreshold && BoneSpeed >= PreviousBoneSpeed;
-
-			if(Moving && MovingSinceTime < 0.0f) //Started moving
-			{
-				MovingSinceTime = Time;
-			}
-			else if(!Moving && MovingSinceTime >= 0.0f) //Stopped moving
-			{
-				const float MovementDuration = Time - MovingSinceTime;
+	return bCompleted;
+}
 
-				if(MovementDuration >= FoleyMinimumMovementDuration)
-				{
-					FFoleyAudioData& NewFoleyAudioData = NewFoleyTrack.FoleyMovements.AddDefaulted_GetRef();
-					NewFoleyAudioData.BoneName = Bone.Key;
-					NewFoleyAudioData.FoleyTime = MovingSinceTime;
-					NewFoleyAudioData.FoleyLength = MovementDuration;
-					NewFoleyAudioData.FoleySpeed = PreviousBoneSpeed;
-				}
+bool UAudioAnimationToolsWidget::AutoGenerateFoleyNotifiesBatch(const TArray<UAnimSequence*>& AnimationSequences, TArray<FName> BoneNames,
+	TSubclassOf<UAnimNotify> AnimNotifyClass, TArray<UAnimSequence*>& ModifiedSequences)
+{
+	ModifiedSequences.Empty();
 
-				MovingSinceTime = -1.0f;
-			}
+	TArray<TArray<FFoleyAudioTrack>> AnimationTracks;
+	TArray<bool> Analyzed;
+	const bool bCompleted = AnalyzeFoleyBatch(AnimationSequences, BoneNames, AnimationTracks, Analyzed);
 
-			PreviousBoneLocation = BoneLocation;
-			PreviousBoneSpeed = BoneSpeed;
+	//Notifies are UObjects on the animations: written back here, on the game thread
+	for (int AnimationIndex = 0; AnimationIndex < AnimationSequences.Num(); AnimationIndex++)
+	{
+		TMap<UAnimNotify*, FFoleyAudioData> CreatedNotifies;
+		if(Analyzed[AnimationIndex] && FAudioAnimationNotifyWriter::WriteFoleyNotifies(AnimationSequences[AnimationIndex], AnimationTracks[AnimationIndex], AnimNotifyClass, CreatedNotifies))
+		{
+			ModifiedSequences.Add(AnimationSequences[AnimationIndex]);
 		}
 	}
-	
-#if WITH_EDITORONLY_DATA
 
-	bool WasAnimationFileModified = false;
-
-	for (FFoleyAudioTrack& FoleyAudioTrack : CreatedTracks)
-	{
-		int NewNotifyTrackIndex = AnimationSequence->AnimNotifyTracks.Num();
+	return bCompleted;
+}
 
-		//If a track already exists with same name clear it (suppose previous generation)
-		for (int TrackId = 0; TrackId < AnimationSequence->AnimNotifyTracks.Num(); TrackId++)
-		{
-			if(AnimationSequence->AnimNotifyTracks[TrackId].TrackName == FoleyAudioTrack.TrackName)
-			{
-				AnimationSequence->Notifies.RemoveAll([TrackId](const FAnimNotifyEvent& NotifyEvent){return NotifyEvent.TrackIndex == TrackId;});
-				NewNotifyTrackIndex = TrackId;
-				WasAnimationFileModified = true;
-			}
-		}
+bool UAudioAnimationToolsWidget::AutoGenerateFootstepNotifiesForBlendSpace(UBlendSpace* BlendSpace, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	TArray<UAnimSequence*>& ModifiedSequences, bool& ConsistentPhases)
+{
+	ModifiedSequences.Empty();
+	ConsistentPhases = false;
 
-		if(AnimationSequence->AnimNotifyTracks.Num() <= NewNotifyTrackIndex)
-		{
-			AnimationSequence->AnimNotifyTracks.SetNum(NewNotifyTrackIndex + 1);
-			AnimationSequence->AnimNotifyTracks[NewNotifyTrackIndex].TrackName = FoleyAudioTrack.TrackName;
-			WasAnimationFileModified = true;
-		}
+	//Samples often share sequences (e.g. the same idle at every direction): each one is analyzed once
+	const TArray<UAnimSequence*> AnimationSequences = GetBlendSpaceSequences(BlendSpace);
 
+	TArray<TArray<FFootstepAudioTrack>> AnimationTracks;
+	TArray<bool> Analyzed;
+	const bool bCompleted = AnalyzeFootstepsBatch(AnimationSequences, BoneNames, AnimationTracks, Analyzed);
 
-		for (FFoleyAudioData& FoleyAudioData : FoleyAudioTrack.FoleyMovements)
+	for (int AnimationIndex = 0; AnimationIndex < AnimationSequences.Num(); AnimationIndex++)
+	{
+		TMap<UAnimNotify*, FFootstepAudioData> CreatedNotifies;
+		if(Analyzed[AnimationIndex] && FAudioAnimationNotifyWriter::WriteFootsteps(AnimationSequences[AnimationIndex], AnimationTracks[AnimationIndex], AnimNotifyClass, GetAnalysisSettings(), FootstepOutput, CreatedNotifies))
 		{
-			FAnimNotifyEvent NewNotifyEvent;
-			NewNotifyEvent.NotifyName = "AutoTag_Foley";
-			UAnimNotify* Notify = NewObject<UAnimNotify>(AnimationSequence, AnimNotifyClass);
-			NewNotifyEvent.Notify = Notify;
-			NewNotifyEvent.SetTime(FoleyAudioData.FoleyTime);
-			NewNotifyEvent.TrackIndex = NewNotifyTrackIndex;
-			
-			AnimationSequence->Notifies.Add(NewNotifyEvent);
-			CreatedNotifies.Add(Notify, FoleyAudioData);
-			
-			WasAnimationFileModified = true;
+			ModifiedSequences.Add(AnimationSequences[AnimationIndex]);
 		}
 	}
 
-	if(WasAnimationFileModified)
+	if(bCompleted)
 	{
-		AnimationSequence->Modify(true);
-		AnimationSequence->RefreshCacheData();
+		ConsistentPhases = FAudioAnimationNotifyWriter::HaveConsistentSyncMarkers(TArray<const UAnimSequence*>(AnimationSequences), AnimationTracks,
+			GetAnalysisSettings(), FootstepOutput.SyncMarkerNames, GetNameSafe(BlendSpace));
 	}
-	
-#endif
+
+	return bCompleted;
 }
 
-void UAudioAnimationToolsWidget::CalculateFootstepsWithHeightThreshold(UAnimSequence* AnimationSequence,
-	TArray<FName> BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks)
+bool UAudioAnimationToolsWidget::AutoGenerateFoleyNotifiesForBlendSpace(UBlendSpace* BlendSpace, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	TArray<UAnimSequence*>& ModifiedSequences)
 {
-	if(AnimationSequence == nullptr)
-	{
-		UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- AutoGenerateFootstepNotifies : passed a null AnimSequence. Early exit."));
-		return;
-	}
+	return AutoGenerateFoleyNotifiesBatch(GetBlendSpaceSequences(BlendSpace), BoneNames, AnimNotifyClass, ModifiedSequences);
+}
+
+void UAudioAnimationToolsWidget::AutoGenerateFootstepNotifiesForMontage(UAnimSequenceBase* MontageOrComposite, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies, TArray<FFootstepAudioTrack>& CreatedTracks)
+{
+	CreatedNotifies.Empty();
 
-	const USkeleton* Skeleton = AnimationSequence->GetSkeleton();
+	FAudioAnimationAnalyzer(GetAnalysisSettings()).AnalyzeSegmentFootsteps(MontageOrComposite, BoneNames, CreatedTracks);
 
-	if(Skeleton == nullptr)
-	{
-		UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- AutoGenerateFootstepNotifies : AnimSequence had a null skeleton. Early exit."));
-		return;
-	}
+	FAudioAnimationNotifyWriter::WriteFootstepNotifies(MontageOrComposite, CreatedTracks, AnimNotifyClass, GetAnalysisSettings(), CreatedNotifies);
+}
 
-	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+void UAudioAnimationToolsWidget::AutoGenerateFoleyNotifiesForMontage(UAnimSequenceBase* MontageOrComposite, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	TMap<UAnimNotify*, FFoleyAudioData>& CreatedNotifies, TArray<FFoleyAudioTrack>& CreatedTracks)
+{
+	CreatedNotifies.Empty();
 
-	TMap<FName, int> BoneIndexesMap;
-	for (FName BoneName : BoneNames)
-	{
-		const int BoneIndex = ReferenceSkeleton.FindBoneIndex(BoneName);
-		if(BoneIndex != INDEX_NONE)
-		{
-			BoneIndexesMap.Add(BoneName, BoneIndex);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- AutoGenerateFootstepNotifies : Bone %s does not exist, skipping it"), *BoneName.ToString());
-		}
-	}
-	
-	FootstepTracks.Empty();
+	FAudioAnimationAnalyzer(GetAnalysisSettings()).AnalyzeSegmentFoley(MontageOrComposite, BoneNames, CreatedTracks);
 
-	for (const TTuple<FName, int>& Bone : BoneIndexesMap)
-	{
-		FFootstepAudioTrack& NewFootstepTrack = FootstepTracks.AddDefaulted_GetRef();
-		NewFootstepTrack.TrackName = FName(*("AutoGen " + Bone.Key.ToString()));
-
-		float GroundContactSinceTime = 0.0f; //Assume feet start on ground
-		//Debug values tracking
-		NewFootstepTrack.HighestBonePosition = GetBoneLocation(AnimationSequence, ReferenceSkeleton, Bone.Value, 0).Z;;
-		NewFootstepTrack.LowestBonePosition = NewFootstepTrack.HighestBonePosition;
-		NewFootstepTrack.FastestBoneSpeed = 0.0f;
-		NewFootstepTrack.SlowestBoneSpeed = -1.0f;
-		
-		for (float Time = AnimationTimeIncrement; Time < AnimationSequence->GetPlayLength(); Time += AnimationTimeIncrement)
-		{
-			const FVector FootLocation = GetBoneLocation(AnimationSequence, ReferenceSkeleton, Bone.Value, Time);
+	FAudioAnimationNotifyWriter::WriteFoleyNotifies(MontageOrComposite, CreatedTracks, AnimNotifyClass, CreatedNotifies);
+}
 
-			const bool GroundContact = GroundContactSinceTime < 0.0f? FootLocation.Z <= GroundContactStartThreshold : FootLocation.Z <= GroundContactStartThreshold + GroundContactStopMargin;
+FAudioAnimationAnalysisSettings UAudioAnimationToolsWidget::GetAnalysisSettings() const
+{
+	FAudioAnimationAnalysisSettings Settings;
+	Settings.GroundContactStartThreshold = GroundContactStartThreshold;
+	Settings.GroundContactStopMargin = GroundContactStopMargin;
+	Settings.FootstepSpeedThreshold = FootstepSpeedThreshold;
+	Settings.FootstepSpeedCalculationWindow = FootstepSpeedCalculationWindow;
+	Settings.FootstepDetectionMethod = FootstepDetectionMethod;
+	Settings.FoleySpeedThreshold = FoleySpeedThreshold;
+	Settings.FoleyMinimumMovementDuration = FoleyMinimumMovementDuration;
+	Settings.FootstepDetectionSensitivity = FootstepDetectionSensitivity;
+	Settings.AnimationEdgesMargin = AnimationEdgesMargin;
+	Settings.VerboseLogging = VerboseLogging;
+	Settings.UseAnalysisCache = UseAnalysisCache;
+	return Settings;
+}
 
-			if(FootLocation.Z > NewFootstepTrack.HighestBonePosition) NewFootstepTrack.HighestBonePosition = FootLocation.Z;
-			if(FootLocation.Z < NewFootstepTrack.LowestBonePosition) NewFootstepTrack.LowestBonePosition = FootLocation.Z;
-			
-			if(VerboseLogging)
-			{
-				UE_LOG(LogTemp, Log, TEXT("AudioAnimationTools : Bone %s height on time %f was %f units."), *Bone.Key.ToString(), Time, FootLocation.Z);
-			}
-			
-			if(GroundContact && GroundContactSinceTime < 0.0f) //New footstep!
-			{
+bool UAudioAnimationToolsWidget::AnalyzeFootstepsBatch(const TArray<UAnimSequence*>& AnimationSequences, const TArray<FName>& BoneNames,
+	TArray<TArray<FFootstepAudioTrack>>& OutAnimationTracks, TArray<bool>& OutAnalyzed) const
+{
+	const FAudioAnimationAnalyzer Analyzer(GetAnalysisSettings());
 
-				if(VerboseLogging)
-				{
-					UE_LOG(LogTemp, Log, TEXT("AudioAnimationTools : Bone %s did a footstep on time %f"), *Bone.Key.ToString(), Time);
-				}
-				
-				GroundContactSinceTime = Time;
-
-				FVector PastFootLocation = GetBoneLocation(AnimationSequence, ReferenceSkeleton, Bone.Value, Time-FootstepSpeedCalculationWindow);
-				const float FootSpeed = ((FootLocation - PastFootLocation)/FootstepSpeedCalculationWindow).Size();
-				FFootstepAudioData& NewFootstep = NewFootstepTrack.Footsteps.AddDefaulted_GetRef();
-				NewFootstep.BoneName = Bone.Key;
-				NewFootstep.FootstepTime = Time;
-				NewFootstep.FootstepSpeed = FootSpeed;
-
-				//Values for filtering
-				if(FootSpeed < NewFootstepTrack.SlowestBoneSpeed || NewFootstepTrack.SlowestBoneSpeed == -1.0f) NewFootstepTrack.SlowestBoneSpeed = FootSpeed;
-				if(FootSpeed > NewFootstepTrack.FastestBoneSpeed) NewFootstepTrack.FastestBoneSpeed = FootSpeed;
-			}
-			else if(!GroundContact && GroundContactSinceTime >= 0.0f) //Foot stopped touching ground
-			{
-				GroundContactSinceTime = -1.0f;
+	OutAnimationTracks.Empty();
+	OutAnimationTracks.SetNum(AnimationSequences.Num());
 
-				if(VerboseLogging)
-				{
-					UE_LOG(LogTemp, Log, TEXT("AudioAnimationTools : Bone %s stopped touching ground on time %f"), *Bone.Key.ToString(), Time);
-				}
-			}
-		}
-	}
+	return AudioAnimationToolsBatch::RunParallel(AnimationSequences.Num(), LOCTEXT("AnalyzingFootsteps", "Analyzing footsteps"),
+		[&](const int AnimationIndex)
+		{
+			Analyzer.AnalyzeFootsteps(AnimationSequences[AnimationIndex], BoneNames, OutAnimationTracks[AnimationIndex]);
+		},
+		OutAnalyzed);
 }
 
-void UAudioAnimationToolsWidget::CalculateFootstepsWithTangents(UAnimSequence* AnimationSequence,
-                                                                TArray<FName> BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks)
+bool UAudioAnimationToolsWidget::AnalyzeFoleyBatch(const TArray<UAnimSequence*>& AnimationSequences, const TArray<FName>& BoneNames,
+	TArray<TArray<FFoleyAudioTrack>>& OutAnimationTracks, TArray<bool>& OutAnalyzed) const
 {
-	FootstepTracks.Empty();
+	const FAudioAnimationAnalyzer Analyzer(GetAnalysisSettings());
 
-	if(AnimationSequence == nullptr)
-	{
-		UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- CalculateFootstepsWithTangents : passed a null AnimSequence. Early exit."));
-		return;
-	}
+	OutAnimationTracks.Empty();
+	OutAnimationTracks.SetNum(AnimationSequences.Num());
 
-	const USkeleton* Skeleton = AnimationSequence->GetSkeleton();
+	return AudioAnimationToolsBatch::RunParallel(AnimationSequences.Num(), LOCTEXT("AnalyzingFoley", "Analyzing foley"),
+		[&](const int AnimationIndex)
+		{
+			Analyzer.AnalyzeFoley(AnimationSequences[AnimationIndex], BoneNames, OutAnimationTracks[AnimationIndex]);
+		},
+		OutAnalyzed);
+}
 
-	if(Skeleton == nullptr)
+TArray<UAnimSequence*> UAudioAnimationToolsWidget::GetBlendSpaceSequences(const UBlendSpace* BlendSpace)
+{
+	TArray<UAnimSequence*> AnimationSequences;
+	if(BlendSpace == nullptr)
 	{
-		UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- CalculateFootstepsWithTangents : AnimSequence had a null skeleton. Early exit."));
-		return;
+		UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- GetBlendSpaceSequences : passed a null BlendSpace. Early exit."));
+		return AnimationSequences;
 	}
 
-	const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
-
-	TMap<FName, int> BoneIndexesMap;
-	for (FName BoneName : BoneNames)
+	for (const FBlendSample& BlendSample : BlendSpace->GetBlendSamples())
 	{
-		const int BoneIndex = ReferenceSkeleton.FindBoneIndex(BoneName);
-		if(BoneIndex != INDEX_NONE)
-		{
-			BoneIndexesMap.Add(BoneName, BoneIndex);
-		}
-		else
+		if(BlendSample.Animation != nullptr)
 		{
-			UE_LOG(LogTemp, Error, TEXT("AudioAnimationToolsWidget -- CalculateFootstepsWithTangents : Bone %s does not exist, skipping it"), *BoneName.ToString());
+			AnimationSequences.AddUnique(BlendSample.Animation.Get());
 		}
 	}
 
-	for (const TTuple<FName, int>& Bone : BoneIndexesMap)
-	{
-		FFootstepAudioTrack& NewFootstepTrack = FootstepTracks.AddDefaulted_GetRef();
-		NewFootstepTrack.TrackName = FName(*("AutoGen " + Bone.Key.ToString()));
-
-		//Debug values tracking
-		NewFootstepTrack.HighestBonePosition = GetBoneLocation(AnimationSequence, ReferenceSkeleton, Bone.Value, 0).Z;;
-		NewFootstepTrack.LowestBonePosition = NewFootstepTrack.HighestBonePosition;
-		NewFootstepTrack.FastestBoneSpeed = 0.0f;
-		NewFootstepTrack.SlowestBoneSpeed = -1.0f;
-		
-		bool wasGoingDown = false;
-		FVector PreviousBoneLocation = FVector::ZeroVector;
-		for (float Time = AnimationTimeIncrement; Time < AnimationSequence->GetPlayLength(); Time+=AnimationTimeIncrement)
-		{
-			FVector BoneLocation = GetBoneLocation(AnimationSequence, ReferenceSkeleton, Bone.Value, Time);
-			bool goingDown = BoneLocation.Z < PreviousBoneLocation.Z-FootstepSpeedThreshold;
-
-			if(BoneLocation.Z > NewFootstepTrack.HighestBonePosition) NewFootstepTrack.HighestBonePosition = BoneLocation.Z;
-			if(BoneLocation.Z < NewFootstepTrack.LowestBonePosition) NewFootstepTrack.LowestBonePosition = BoneLocation.Z;
-			
-			if(!goingDown && wasGoingDown) //Footstep!
-			{
-				const float FootSpeed = ((BoneLocation - PreviousBoneLocation)/FootstepSpeedCalculationWindow).Size();
-				FFootstepAudioData& NewFootstep = NewFootstepTrack.Footsteps.AddDefaulted_GetRef();
-				NewFootstep.BoneName = Bone.Key;
-				NewFootstep.FootstepTime = Time;
-				NewFootstep.FootstepSpeed = FootSpeed;
-
-				//Values for filtering
-				if(FootSpeed < NewFootstepTrack.SlowestBoneSpeed || NewFootstepTrack.SlowestBoneSpeed == -1.0f) NewFootstepTrack.SlowestBoneSpeed = FootSpeed;
-				if(FootSpeed > NewFootstepTrack.FastestBoneSpeed) NewFootstepTrack.FastestBoneSpeed = FootSpeed;
-			}
-
-			wasGoingDown = goingDown;
-			PreviousBoneLocation = BoneLocation;
-		}
-	}
-	
+	return AnimationSequences;
 }
 
 int UAudioAnimationToolsWidget::GetAnimationTrackIndex(const int SkeletonBoneIndex, const UAnimSequence* AnimSequence)
@@ -399,52 +270,4 @@ int UAudioAnimationToolsWidget::GetAnimationTrackIndex(const int SkeletonBoneInd
 	return INDEX_NONE;
 }
 
-FVector UAudioAnimationToolsWidget::GetBoneLocation(const UAnimSequence* AnimSequence,
-	const FReferenceSkeleton& ReferenceSkeleton, const int BoneIndex, const float Time)
-{
-	FTransform RootTransform;
-	GetWorldToRootTransform(AnimSequence, Time, RootTransform);
-
-	FTransform FootTransform;
-	GetRootToBoneTransform(AnimSequence, ReferenceSkeleton, BoneIndex, Time, FootTransform);
-
-	return RootTransform.TransformPosition(FootTransform.GetLocation());
-}
-
-void UAudioAnimationToolsWidget::GetWorldToRootTransform(const UAnimSequence* AnimSequence, const double Time,
-                                                         FTransform& OutTransform)
-{
-	const FSkeletonPoseBoneIndex RootBoneIndex = FSkeletonPoseBoneIndex(0);
-	if(RootBoneIndex != INDEX_NONE)
-	{
-		AnimSequence->GetBoneTransform(OutTransform, RootBoneIndex, Time, false);
-	}
-}
-
-void UAudioAnimationToolsWidget::GetRootToBoneTransform(const UAnimSequence* AnimSequence, const FReferenceSkeleton& ReferenceSkeleton, const int BoneIndex, const double Time,
-	FTransform& OutTransform)
-{
-	OutTransform = FTransform::Identity;
-
-	int CurrentBoneIndex = BoneIndex;
-	int NextBoneIndex = ReferenceSkeleton.GetParentIndex(CurrentBoneIndex);
-
-	while(NextBoneIndex != INDEX_NONE)
-	{
-		FTransform ParentTransform;
-		const FSkeletonPoseBoneIndex BoneIndex = FSkeletonPoseBoneIndex(CurrentBoneIndex);
-		if(BoneIndex == INDEX_NONE)
-		{
-			ParentTransform = ReferenceSkeleton.GetRefBonePose()[CurrentBoneIndex];
-		}
-		else
-		{
-			AnimSequence->GetBoneTransform(ParentTransform, BoneIndex, Time, false);
-		}
-
-		OutTransform = OutTransform * ParentTransform;
-		CurrentBoneIndex = NextBoneIndex;
-		NextBoneIndex = ReferenceSkeleton.GetParentIndex(CurrentBoneIndex);
-	}
-	
-}
+#undef LOCTEXT_NAMESPACE
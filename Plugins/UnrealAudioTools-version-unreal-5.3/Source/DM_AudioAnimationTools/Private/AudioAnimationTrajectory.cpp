@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioAnimationTrajectory.h"
+
+void FAudioAnimationTrajectories::Init(TConstArrayView<float> InTimes, const int NumBones)
+{
+	Times.Reset();
+	Times.Append(InTimes.GetData(), InTimes.Num());
+
+	InverseIntervals.SetNumUninitialized(Times.Num());
+	for (int Sample = 0; Sample < Times.Num(); Sample++)
+	{
+		InverseIntervals[Sample] = Sample > 0 ? 1.0f / (Times[Sample] - Times[Sample - 1]) : 0.0f;
+	}
+
+	for (TArray<TArray<float>>* Coordinate : {&X, &Y, &Z})
+	{
+		Coordinate->SetNum(NumBones);
+		for (TArray<float>& BoneValues : *Coordinate)
+		{
+			BoneValues.SetNumUninitialized(Times.Num());
+		}
+	}
+}
+
+namespace AudioAnimationKernels
+{
+	/** Writes the four comparison results of a vector mask */
+	static void StoreMask(const VectorRegister4Float& Mask, bool* Out)
+	{
+		const int Bits = VectorMaskBits(Mask);
+		Out[0] = (Bits & 1) != 0;
+		Out[1] = (Bits & 2) != 0;
+		Out[2] = (Bits & 4) != 0;
+		Out[3] = (Bits & 8) != 0;
+	}
+
+	void Speeds(TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z, TConstArrayView<float> InverseIntervals, TArrayView<float> Out)
+	{
+		const int Num = Out.Num();
+		if(Num == 0)
+		{
+			return;
+		}
+
+		Out[0] = 0.0f;
+
+		//Each sample against the previous one: unaligned loads one float apart
+		int Sample = 1;
+		for (; Sample + 4 <= Num; Sample += 4)
+		{
+			const VectorRegister4Float DeltaX = VectorSubtract(VectorLoad(&X[Sample]), VectorLoad(&X[Sample - 1]));
+			const VectorRegister4Float DeltaY = VectorSubtract(VectorLoad(&Y[Sample]), VectorLoad(&Y[Sample - 1]));
+			const VectorRegister4Float DeltaZ = VectorSubtract(VectorLoad(&Z[Sample]), VectorLoad(&Z[Sample - 1]));
+
+			VectorRegister4Float SquaredDistance = VectorMultiply(DeltaX, DeltaX);
+			SquaredDistance = VectorMultiplyAdd(DeltaY, DeltaY, SquaredDistance);
+			SquaredDistance = VectorMultiplyAdd(DeltaZ, DeltaZ, SquaredDistance);
+
+			VectorStore(VectorMultiply(VectorSqrt(SquaredDistance), VectorLoad(&InverseIntervals[Sample])), &Out[Sample]);
+		}
+
+		for (; Sample < Num; Sample++)
+		{
+			const FVector3f Delta(X[Sample] - X[Sample - 1], Y[Sample] - Y[Sample - 1], Z[Sample] - Z[Sample - 1]);
+			Out[Sample] = Delta.Size() * InverseIntervals[Sample];
+		}
+	}
+
+	void Derivative(TConstArrayView<float> Values, TConstArrayView<float> InverseIntervals, TArrayView<float> Out)
+	{
+		const int Num = Out.Num();
+		if(Num == 0)
+		{
+			return;
+		}
+
+		Out[0] = 0.0f;
+
+		int Sample = 1;
+		for (; Sample + 4 <= Num; Sample += 4)
+		{
+			const VectorRegister4Float Delta = VectorSubtract(VectorLoad(&Values[Sample]), VectorLoad(&Values[Sample - 1]));
+			VectorStore(VectorMultiply(Delta, VectorLoad(&InverseIntervals[Sample])), &Out[Sample]);
+		}
+
+		for (; Sample < Num; Sample++)
+		{
+			Out[Sample] = (Values[Sample] - Values[Sample - 1]) * InverseIntervals[Sample];
+		}
+	}
+
+	void LessOrEqual(TConstArrayView<float> Values, const float Threshold, TArrayView<bool> Out)
+	{
+		const VectorRegister4Float ThresholdVector = VectorSetFloat1(Threshold);
+
+		int Sample = 0;
+		for (; Sample + 4 <= Values.Num(); Sample += 4)
+		{
+			StoreMask(VectorCompareLE(VectorLoad(&Values[Sample]), ThresholdVector), &Out[Sample]);
+		}
+
+		for (; Sample < Values.Num(); Sample++)
+		{
+			Out[Sample] = Values[Sample] <= Threshold;
+		}
+	}
+
+	void Less(TConstArrayView<float> Values, const float Threshold, TArrayView<bool> Out)
+	{
+		const VectorRegister4Float ThresholdVector = VectorSetFloat1(Threshold);
+
+		int Sample = 0;
+		for (; Sample + 4 <= Values.Num(); Sample += 4)
+		{
+			StoreMask(VectorCompareLT(VectorLoad(&Values[Sample]), ThresholdVector), &Out[Sample]);
+		}
+
+		for (; Sample < Values.Num(); Sample++)
+		{
+			Out[Sample] = Values[Sample] < Threshold;
+		}
+	}
+
+	void MinMax(TConstArrayView<float> Values, float& OutMin, float& OutMax)
+	{
+		if(Values.Num() == 0)
+		{
+			OutMin = OutMax = 0.0f;
+			return;
+		}
+
+		VectorRegister4Float MinVector = VectorSetFloat1(Values[0]);
+		VectorRegister4Float MaxVector = MinVector;
+
+		int Sample = 0;
+		for (; Sample + 4 <= Values.Num(); Sample += 4)
+		{
+			const VectorRegister4Float SampleVector = VectorLoad(&Values[Sample]);
+			MinVector = VectorMin(MinVector, SampleVector);
+			MaxVector = VectorMax(MaxVector, SampleVector);
+		}
+
+		float Mins[4];
+		float Maxs[4];
+		VectorStore(MinVector, Mins);
+		VectorStore(MaxVector, Maxs);
+		OutMin = FMath::Min(FMath::Min(Mins[0], Mins[1]), FMath::Min(Mins[2], Mins[3]));
+		OutMax = FMath::Max(FMath::Max(Maxs[0], Maxs[1]), FMath::Max(Maxs[2], Maxs[3]));
+
+		for (; Sample < Values.Num(); Sample++)
+		{
+			OutMin = FMath::Min(OutMin, Values[Sample]);
+			OutMax = FMath::Max(OutMax, Values[Sample]);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Sampled component space locations of a set of bones, one float array per coordinate.
+ *
+ * Detectors run the kernels below over whole arrays, four samples at a time, then walk the results
+ * for the events they look for. New detectors can reuse the same trajectories and kernels.
+ */
+struct FAudioAnimationTrajectories
+{
+	/** Sample times, shared by all bones */
+	TArray<float> Times;
+
+	/** 1 / (Times[i] - Times[i - 1]), 0 for the first sample */
+	TArray<float> InverseIntervals;
+
+	/** Per bone, per sample */
+	TArray<TArray<float>> X;
+	TArray<TArray<float>> Y;
+	TArray<TArray<float>> Z;
+
+	/** Sizes the arrays for NumBones bones over these times */
+	void Init(TConstArrayView<float> InTimes, int NumBones);
+
+	int NumSamples() const { return Times.Num(); }
+
+	FVector GetLocation(const int Bone, const int Sample) const { return FVector(X[Bone][Sample], Y[Bone][Sample], Z[Bone][Sample]); }
+};
+
+/** SIMD kernels over sample arrays. Every array has the same number of samples. */
+namespace AudioAnimationKernels
+{
+	/** Out[i] = |P[i] - P[i - 1]| * InverseIntervals[i], 0 for the first sample */
+	void Speeds(TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z, TConstArrayView<float> InverseIntervals, TArrayView<float> Out);
+
+	/** Out[i] = (Values[i] - Values[i - 1]) * InverseIntervals[i], 0 for the first sample */
+	void Derivative(TConstArrayView<float> Values, TConstArrayView<float> InverseIntervals, TArrayView<float> Out);
+
+	/** Out[i] = Values[i] <= Threshold */
+	void LessOrEqual(TConstArrayView<float> Values, float Threshold, TArrayView<bool> Out);
+
+	/** Out[i] = Values[i] < Threshold */
+	void Less(TConstArrayView<float> Values, float Threshold, TArrayView<bool> Out);
+
+	void MinMax(TConstArrayView<float> Values, float& OutMin, float& OutMax);
+}
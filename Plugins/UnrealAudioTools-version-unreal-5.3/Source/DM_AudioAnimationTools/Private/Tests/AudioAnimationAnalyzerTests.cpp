@@ -0,0 +1,480 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AudioAnimationAnalyzer.h"
+
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "Misc/AutomationTest.h"
+#include "ReferenceSkeleton.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AudioAnimationAnalyzerTests
+{
+	static const FName RootBone = TEXT("root");
+	static const FName PelvisBone = TEXT("pelvis");
+	static const FName LeftThighBone = TEXT("thigh_l");
+	static const FName LeftFootBone = TEXT("foot_l");
+	static const FName RightFootBone = TEXT("foot_r");
+	static const FName HandBone = TEXT("hand_r");
+	static const FName SpineBone = TEXT("spine_01");
+
+	/**Time between two contacts of the same foot. The other foot touches the ground half a cycle later.*/
+	static constexpr float StepCycle = 0.8f;
+
+	/**Highest foot height, half a cycle after its contact*/
+	static constexpr float FootLiftHeight = 40.0f;
+
+	/**Contact of the left foot in the cycle. Both feet start in the air.*/
+	static constexpr float LeftContactPhase = 0.25f;
+
+	/**Forward speed of the feet*/
+	static constexpr float WalkSpeed = 150.0f;
+
+	/**The hand accelerates for this long from the start of each movement, then stops*/
+	static constexpr float HandMovementDuration = 0.3f;
+
+	/**Hand distance over the square of the time since the movement started: the hand speed grows by twice this per second*/
+	static constexpr float HandAcceleration = 1000.0f;
+
+	/**Time between the starts of two hand movements, the first one at HandMovementPeriod / 4*/
+	static constexpr float HandMovementPeriod = 1.0f;
+
+	/**
+	 * Feet move straight down to the ground and straight up again (a triangle wave), so the key interpolation of the sequence
+	 * follows the analytic trajectory everywhere but at the contacts themselves. Height crossings then have exact expected times.
+	 */
+	static float GetFootHeight(const float Time, const float ContactPhase)
+	{
+		const float CyclePosition = FMath::Frac(Time / StepCycle - ContactPhase);
+		return FootLiftHeight * 2.0f * FMath::Min(CyclePosition, 1.0f - CyclePosition);
+	}
+
+	/**Vertical speed of the feet between two contacts*/
+	static float GetFootVerticalSpeed()
+	{
+		return 2.0f * FootLiftHeight / StepCycle;
+	}
+
+	/**Contacts up to a cycle past the end, whose crossings may still lie in the animation*/
+	static void GetContactTimes(const float Length, const float ContactPhase, TArray<float>& OutTimes)
+	{
+		for (float Time = ContactPhase * StepCycle; Time < Length + StepCycle; Time += StepCycle)
+		{
+			OutTimes.Add(Time);
+		}
+	}
+
+	/**Movements ending early enough for the analysis to see the hand stop*/
+	static void GetHandMovementStartTimes(const float Length, TArray<float>& OutTimes)
+	{
+		for (float Time = 0.25f * HandMovementPeriod; Time + HandMovementDuration + 0.1f < Length; Time += HandMovementPeriod)
+		{
+			OutTimes.Add(Time);
+		}
+	}
+
+	static float GetHandDistance(const float Time, const TArray<float>& MovementStartTimes)
+	{
+		float Distance = 0.0f;
+		for (const float StartTime : MovementStartTimes)
+		{
+			const float MovementTime = FMath::Clamp(Time - StartTime, 0.0f, HandMovementDuration);
+			Distance += HandAcceleration * MovementTime * MovementTime;
+		}
+		return Distance;
+	}
+
+	/**Reference pose of the pelvis, relative to the root: raised and turned, so the bones below it are not in component space*/
+	static FTransform GetPelvisTransform()
+	{
+		return FTransform(FRotator(0.0f, 90.0f, 0.0f), FVector(0.0f, 0.0f, 95.0f));
+	}
+
+	/**Reference pose of the left thigh, relative to the pelvis: pointing down and tilted*/
+	static FTransform GetLeftThighTransform()
+	{
+		return FTransform(FRotator(-80.0f, 20.0f, 15.0f), FVector(5.0f, 10.0f, -8.0f));
+	}
+
+	/**
+	 * Skeleton with a root and the test bones, at the origin in the reference pose. The left foot hangs from a root, pelvis and thigh chain
+	 * with rotated, unanimated parents, so its local keys only give the expected component space motion once composed with them.
+	 */
+	static USkeleton* CreateSkeleton()
+	{
+		USkeletalMesh* SkeletalMesh = NewObject<USkeletalMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+		USkeleton* Skeleton = NewObject<USkeleton>(GetTransientPackage(), NAME_None, RF_Transient);
+
+		{
+			FReferenceSkeletonModifier Modifier(SkeletalMesh->GetRefSkeleton(), Skeleton);
+			Modifier.Add(FMeshBoneInfo(RootBone, RootBone.ToString(), INDEX_NONE), FTransform::Identity);
+			for (const FName BoneName : {RightFootBone, HandBone, SpineBone})
+			{
+				Modifier.Add(FMeshBoneInfo(BoneName, BoneName.ToString(), 0), FTransform::Identity);
+			}
+
+			const int PelvisIndex = Modifier.GetReferenceSkeleton().GetRawBoneNum();
+			Modifier.Add(FMeshBoneInfo(PelvisBone, PelvisBone.ToString(), 0), GetPelvisTransform());
+			Modifier.Add(FMeshBoneInfo(LeftThighBone, LeftThighBone.ToString(), PelvisIndex), GetLeftThighTransform());
+			Modifier.Add(FMeshBoneInfo(LeftFootBone, LeftFootBone.ToString(), PelvisIndex + 1), FTransform::Identity);
+		}
+
+		Skeleton->MergeAllBonesToBoneTree(SkeletalMesh);
+		return Skeleton;
+	}
+
+	/**Walking sequence keyed at FrameRate: both feet stepping, the hand moving now and then, the spine still*/
+	static UAnimSequence* CreateSequence(USkeleton* Skeleton, const int FrameRate, const float Length)
+	{
+		UAnimSequence* AnimationSequence = NewObject<UAnimSequence>(GetTransientPackage(), NAME_None, RF_Transient);
+		AnimationSequence->SetSkeleton(Skeleton);
+
+		const int NumFrames = FMath::RoundToInt(Length * FrameRate);
+
+		TArray<float> HandMovementStartTimes;
+		GetHandMovementStartTimes(Length, HandMovementStartTimes);
+
+		//The left foot is keyed relative to its thigh, for the same component space motion as the right foot
+		const FTransform LeftThighComponentTransform = GetLeftThighTransform() * GetPelvisTransform();
+
+		TArray<FVector3f> LeftFootPositions, RightFootPositions, HandPositions;
+		for (int Frame = 0; Frame <= NumFrames; Frame++)
+		{
+			const float Time = static_cast<float>(Frame) / FrameRate;
+			const FVector LeftFootComponentPosition(WalkSpeed * Time, 10.0f, GetFootHeight(Time, LeftContactPhase));
+			LeftFootPositions.Emplace(LeftThighComponentTransform.InverseTransformPosition(LeftFootComponentPosition));
+			RightFootPositions.Emplace(WalkSpeed * Time, -10.0f, GetFootHeight(Time, LeftContactPhase + 0.5f));
+			HandPositions.Emplace(GetHandDistance(Time, HandMovementStartTimes), -30.0f, 100.0f);
+		}
+
+		TArray<FQuat4f> Rotations;
+		Rotations.Init(FQuat4f::Identity, NumFrames + 1);
+		TArray<FVector3f> Scales;
+		Scales.Init(FVector3f::OneVector, NumFrames + 1);
+
+		IAnimationDataController& Controller = AnimationSequence->GetController();
+		Controller.InitializeModel();
+		Controller.SetFrameRate(FFrameRate(FrameRate, 1), false);
+		Controller.SetNumberOfFrames(FFrameNumber(NumFrames), false);
+
+		auto AddBoneTrack = [&Controller, &Scales](const FName BoneName, const TArray<FVector3f>& Positions, const TArray<FQuat4f>& BoneRotations)
+		{
+			Controller.AddBoneCurve(BoneName, false);
+			Controller.SetBoneTrackKeys(BoneName, Positions, BoneRotations, Scales, false);
+		};
+
+		//Cancels the rotation of the thigh, which makes no difference to the foot position but keeps the keys plausible
+		TArray<FQuat4f> LeftFootRotations;
+		LeftFootRotations.Init(FQuat4f(LeftThighComponentTransform.GetRotation().Inverse()), NumFrames + 1);
+
+		AddBoneTrack(LeftFootBone, LeftFootPositions, LeftFootRotations);
+		AddBoneTrack(RightFootBone, RightFootPositions, Rotations);
+		AddBoneTrack(HandBone, HandPositions, Rotations);
+
+		Controller.NotifyPopulated();
+
+		//Analyzed as the tools would, from the compressed data of the editor platform
+		AnimationSequence->CacheDerivedDataForCurrentPlatform();
+
+		return AnimationSequence;
+	}
+
+	static FAudioAnimationAnalysisSettings GetTestSettings(const EFootstepDetectionMethod Method)
+	{
+		FAudioAnimationAnalysisSettings Settings;
+		Settings.FootstepDetectionMethod = Method;
+		//High enough for the crossings to lie a few frames before the contacts at every tested frame rate
+		Settings.GroundContactStartThreshold = 10.0f;
+		Settings.GroundContactStopMargin = 3.0f;
+		Settings.FootstepSpeedThreshold = 1.0f;
+		Settings.FoleySpeedThreshold = 10.0f;
+		Settings.FoleyMinimumMovementDuration = 0.05f;
+		//Every analysis has to run, for both the checks and the timings
+		Settings.UseAnalysisCache = false;
+		return Settings;
+	}
+
+	static void GetFootstepTimes(const TArray<FFootstepAudioTrack>& FootstepTracks, const FName TrackName, TArray<float>& OutTimes)
+	{
+		for (const FFootstepAudioTrack& FootstepTrack : FootstepTracks)
+		{
+			if(FootstepTrack.TrackName == TrackName)
+			{
+				for (const FFootstepAudioData& Footstep : FootstepTrack.Footsteps)
+				{
+					OutTimes.Add(Footstep.FootstepTime);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Every expected time inside the window has a detected time within Tolerance, and every detected time has an expected one.
+	 * Detections closer than Tolerance to the window edges may match expected times outside of it, so they are not checked.
+	 */
+	static void TestTimes(FAutomationTestBase& Test, const FString& What, const TArray<float>& ExpectedTimes, const TArray<float>& DetectedTimes,
+		const float Tolerance, const float WindowStart, const float WindowEnd)
+	{
+		auto FindClosest = [](const TArray<float>& Times, const float Time)
+		{
+			float Closest = TNumericLimits<float>::Max();
+			for (const float CandidateTime : Times)
+			{
+				if(FMath::Abs(CandidateTime - Time) < FMath::Abs(Closest - Time))
+				{
+					Closest = CandidateTime;
+				}
+			}
+			return Closest;
+		};
+
+		for (const float ExpectedTime : ExpectedTimes)
+		{
+			if(ExpectedTime >= WindowStart && ExpectedTime <= WindowEnd)
+			{
+				const float DetectedTime = FindClosest(DetectedTimes, ExpectedTime);
+				Test.TestTrue(FString::Printf(TEXT("%s: expected at %.4fs, closest detection at %.4fs (tolerance %.4fs)"), *What, ExpectedTime, DetectedTime, Tolerance),
+					FMath::Abs(DetectedTime - ExpectedTime) <= Tolerance);
+			}
+		}
+
+		for (const float DetectedTime : DetectedTimes)
+		{
+			if(DetectedTime >= WindowStart + Tolerance && DetectedTime <= WindowEnd - Tolerance)
+			{
+				const float ExpectedTime = FindClosest(ExpectedTimes, DetectedTime);
+				Test.TestTrue(FString::Printf(TEXT("%s: unexpected detection at %.4fs"), *What, DetectedTime), FMath::Abs(DetectedTime - ExpectedTime) <= Tolerance);
+			}
+		}
+	}
+
+	/**Analysis time, in milliseconds per second of animation*/
+	static double GetMillisecondsPerSecond(const double StartSeconds, const float Length)
+	{
+		return (FPlatformTime::Seconds() - StartSeconds) * 1000.0 / Length;
+	}
+
+	/**Analyzes a generated sequence with both footstep methods and the foley detection, checking every detection against the generated motion*/
+	static void TestSequence(FAutomationTestBase& Test, USkeleton* Skeleton, const int FrameRate, const float Length)
+	{
+		const UAnimSequence* AnimationSequence = CreateSequence(Skeleton, FrameRate, Length);
+		const FString Context = FString::Printf(TEXT("%dfps %.1fs"), FrameRate, Length);
+		const float FrameInterval = 1.0f / FrameRate;
+
+		TArray<float> LeftContactTimes, RightContactTimes;
+		GetContactTimes(Length, LeftContactPhase, LeftContactTimes);
+		GetContactTimes(Length, LeftContactPhase + 0.5f, RightContactTimes);
+
+		const TArray<FName> FootBones = {LeftFootBone, RightFootBone};
+		const TArray<FName> TrackNames = {TEXT("AutoGen foot_l"), TEXT("AutoGen foot_r")};
+		const TArray<float>* ContactTimes[] = {&LeftContactTimes, &RightContactTimes};
+
+		//Height threshold: the crossing of the start threshold, on the way down. Refined well under a frame.
+		{
+			const FAudioAnimationAnalysisSettings Settings = GetTestSettings(EFootstepDetectionMethod::HeightThreshold);
+			const float CrossingDelay = Settings.GroundContactStartThreshold / GetFootVerticalSpeed();
+
+			const double StartSeconds = FPlatformTime::Seconds();
+			TArray<FFootstepAudioTrack> FootstepTracks;
+			FAudioAnimationAnalyzer(Settings).AnalyzeFootsteps(AnimationSequence, FootBones, FootstepTracks);
+			const double MillisecondsPerSecond = GetMillisecondsPerSecond(StartSeconds, Length);
+
+			for (int Foot = 0; Foot < FootBones.Num(); Foot++)
+			{
+				TArray<float> ExpectedTimes;
+				for (const float ContactTime : *ContactTimes[Foot])
+				{
+					ExpectedTimes.Add(ContactTime - CrossingDelay);
+				}
+
+				TArray<float> DetectedTimes;
+				GetFootstepTimes(FootstepTracks, TrackNames[Foot], DetectedTimes);
+
+				TestTimes(Test, FString::Printf(TEXT("%s HeightThreshold %s"), *Context, *FootBones[Foot].ToString()), ExpectedTimes, DetectedTimes, 0.002f,
+					FrameInterval, Length - 2.0f * FrameInterval);
+			}
+
+			//Heights are in component space, the nested left foot included: the lowest frame is at most half a frame of motion above the ground
+			for (const FFootstepAudioTrack& FootstepTrack : FootstepTracks)
+			{
+				const float GroundTolerance = 0.5f * GetFootVerticalSpeed() * FrameInterval + 0.1f;
+				Test.TestTrue(FString::Printf(TEXT("%s %s lowest height %.3f, on the ground within %.3f"), *Context, *FootstepTrack.TrackName.ToString(), FootstepTrack.LowestBonePosition, GroundTolerance),
+					FootstepTrack.LowestBonePosition >= -0.1f && FootstepTrack.LowestBonePosition <= GroundTolerance);
+			}
+
+			Test.AddInfo(FString::Printf(TEXT("%s HeightThreshold: %.3f ms per second of animation"), *Context, MillisecondsPerSecond));
+			Test.AddTelemetryData(TEXT("HeightThreshold ms per second"), MillisecondsPerSecond, Context);
+		}
+
+		//Tangents: the lowest point of the foot. The pose between keys is interpolated, so the lowest pose is a key: within a frame.
+		{
+			const FAudioAnimationAnalysisSettings Settings = GetTestSettings(EFootstepDetectionMethod::TangentCalculation);
+
+			const double StartSeconds = FPlatformTime::Seconds();
+			TArray<FFootstepAudioTrack> FootstepTracks;
+			FAudioAnimationAnalyzer(Settings).AnalyzeFootsteps(AnimationSequence, FootBones, FootstepTracks);
+			const double MillisecondsPerSecond = GetMillisecondsPerSecond(StartSeconds, Length);
+
+			for (int Foot = 0; Foot < FootBones.Num(); Foot++)
+			{
+				TArray<float> DetectedTimes;
+				GetFootstepTimes(FootstepTracks, TrackNames[Foot], DetectedTimes);
+
+				TestTimes(Test, FString::Printf(TEXT("%s TangentCalculation %s"), *Context, *FootBones[Foot].ToString()), *ContactTimes[Foot], DetectedTimes,
+					FrameInterval + 0.002f, 2.0f * FrameInterval, Length - 2.0f * FrameInterval);
+			}
+
+			Test.AddInfo(FString::Printf(TEXT("%s TangentCalculation: %.3f ms per second of animation"), *Context, MillisecondsPerSecond));
+			Test.AddTelemetryData(TEXT("TangentCalculation ms per second"), MillisecondsPerSecond, Context);
+		}
+
+		//Foley: the hand starts moving once its speed reaches the threshold, and stops with it. Not refined: within two frames.
+		{
+			const FAudioAnimationAnalysisSettings Settings = GetTestSettings(EFootstepDetectionMethod::HeightThreshold);
+			const float ThresholdDelay = Settings.FoleySpeedThreshold / (2.0f * HandAcceleration);
+
+			const double StartSeconds = FPlatformTime::Seconds();
+			TArray<FFoleyAudioTrack> FoleyTracks;
+			FAudioAnimationAnalyzer(Settings).AnalyzeFoley(AnimationSequence, {HandBone, SpineBone}, FoleyTracks);
+			const double MillisecondsPerSecond = GetMillisecondsPerSecond(StartSeconds, Length);
+
+			TArray<float> MovementStartTimes;
+			GetHandMovementStartTimes(Length, MovementStartTimes);
+
+			TArray<float> ExpectedTimes, ExpectedEndTimes;
+			for (const float MovementStartTime : MovementStartTimes)
+			{
+				ExpectedTimes.Add(MovementStartTime + ThresholdDelay);
+				ExpectedEndTimes.Add(MovementStartTime + HandMovementDuration);
+			}
+
+			TArray<float> DetectedTimes, DetectedEndTimes;
+			for (const FFoleyAudioTrack& FoleyTrack : FoleyTracks)
+			{
+				if(FoleyTrack.TrackName == TEXT("AutoGen spine_01"))
+				{
+					Test.TestEqual(FString::Printf(TEXT("%s Foley movements of a still bone"), *Context), FoleyTrack.FoleyMovements.Num(), 0);
+				}
+
+				for (const FFoleyAudioData& Movement : FoleyTrack.FoleyMovements)
+				{
+					if(Movement.BoneName == HandBone)
+					{
+						DetectedTimes.Add(Movement.FoleyTime);
+						DetectedEndTimes.Add(Movement.FoleyTime + Movement.FoleyLength);
+					}
+				}
+			}
+
+			Test.TestEqual(FString::Printf(TEXT("%s Foley movements of the hand"), *Context), DetectedTimes.Num(), ExpectedTimes.Num());
+			TestTimes(Test, FString::Printf(TEXT("%s Foley start"), *Context), ExpectedTimes, DetectedTimes, 2.0f * FrameInterval, 0.0f, Length);
+			TestTimes(Test, FString::Printf(TEXT("%s Foley end"), *Context), ExpectedEndTimes, DetectedEndTimes, 2.0f * FrameInterval, 0.0f, Length);
+
+			Test.AddInfo(FString::Printf(TEXT("%s Foley: %.3f ms per second of animation"), *Context, MillisecondsPerSecond));
+			Test.AddTelemetryData(TEXT("Foley ms per second"), MillisecondsPerSecond, Context);
+		}
+	}
+
+	/**
+	 * Montage playing the sequence forward, then backwards. Backwards, the foot lands where its contact ends in the sequence:
+	 * every montage footstep starts a remapped ground contact and lasts as long as it.
+	 */
+	static void TestReversedSegment(FAutomationTestBase& Test, USkeleton* Skeleton, const int FrameRate, const float Length)
+	{
+		UAnimSequence* AnimationSequence = CreateSequence(Skeleton, FrameRate, Length);
+		const FString Context = FString::Printf(TEXT("%dfps %.1fs reversed segment"), FrameRate, Length);
+		const FAudioAnimationAnalysisSettings Settings = GetTestSettings(EFootstepDetectionMethod::HeightThreshold);
+		const TArray<FName> FootBones = {LeftFootBone, RightFootBone};
+
+		UAnimMontage* Montage = NewObject<UAnimMontage>(GetTransientPackage(), NAME_None, RF_Transient);
+		Montage->SetSkeleton(Skeleton);
+		FSlotAnimationTrack& SlotTrack = Montage->SlotAnimTracks.AddDefaulted_GetRef();
+		SlotTrack.SlotName = FAnimSlotGroup::DefaultSlotName;
+		for (const float PlayRate : {1.0f, -1.0f})
+		{
+			FAnimSegment& Segment = SlotTrack.AnimTrack.AnimSegments.AddDefaulted_GetRef();
+			Segment.SetAnimReference(AnimationSequence);
+			Segment.AnimStartTime = 0.0f;
+			Segment.AnimEndTime = Length;
+			Segment.AnimPlayRate = PlayRate;
+			Segment.LoopingCount = 1;
+			Segment.StartPos = PlayRate > 0.0f ? 0.0f : Length;
+		}
+
+		const FAudioAnimationAnalyzer Analyzer(Settings);
+		TArray<FFootstepAudioTrack> SequenceTracks, MontageTracks;
+		Analyzer.AnalyzeFootsteps(AnimationSequence, FootBones, SequenceTracks);
+		Analyzer.AnalyzeSegmentFootsteps(Montage, FootBones, MontageTracks);
+
+		for (const FFootstepAudioTrack& SequenceTrack : SequenceTracks)
+		{
+			//Backwards, a contact from FootstepTime to its end lands at the mirrored end, clamped to the sequence
+			TArray<float> ExpectedTimes, DetectedTimes;
+			for (const FFootstepAudioData& Footstep : SequenceTrack.Footsteps)
+			{
+				ExpectedTimes.Add(2.0f * Length - FMath::Min(Footstep.FootstepTime + Footstep.ContactDuration, Length));
+			}
+			GetFootstepTimes(MontageTracks, SequenceTrack.TrackName, DetectedTimes);
+			DetectedTimes.RemoveAll([Length](const float Time){return Time < Length;});
+
+			TestTimes(Test, FString::Printf(TEXT("%s %s"), *Context, *SequenceTrack.TrackName.ToString()), ExpectedTimes, DetectedTimes, 0.001f, Length, 2.0f * Length);
+		}
+
+		for (const FFootstepAudioTrack& MontageTrack : MontageTracks)
+		{
+			for (const FFootstepAudioData& Footstep : MontageTrack.Footsteps)
+			{
+				const bool bMatchesContact = MontageTrack.GroundContacts.ContainsByPredicate([&Footstep](const FFootContactInterval& Contact)
+				{
+					return FMath::IsNearlyEqual(Contact.StartTime, Footstep.FootstepTime, 0.001f)
+						&& FMath::IsNearlyEqual(Contact.EndTime, Footstep.FootstepTime + Footstep.ContactDuration, 0.001f);
+				});
+				Test.TestTrue(FString::Printf(TEXT("%s %s footstep at %.4fs lasting %.4fs matches a ground contact"), *Context, *MontageTrack.TrackName.ToString(),
+					Footstep.FootstepTime, Footstep.ContactDuration), bMatchesContact);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioAnimationAnalyzerAccuracyTest, "DemuteAudioTools.AudioAnimationAnalyzer.Accuracy",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAudioAnimationAnalyzerAccuracyTest::RunTest(const FString& Parameters)
+{
+	USkeleton* Skeleton = AudioAnimationAnalyzerTests::CreateSkeleton();
+
+	for (const int FrameRate : {24, 30, 60, 120})
+	{
+		for (const float Length : {1.0f, 3.2f, 10.0f})
+		{
+			AudioAnimationAnalyzerTests::TestSequence(*this, Skeleton, FrameRate, Length);
+		}
+	}
+
+	AudioAnimationAnalyzerTests::TestReversedSegment(*this, Skeleton, 30, 3.2f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioAnimationAnalyzerPerformanceTest, "DemuteAudioTools.AudioAnimationAnalyzer.Performance",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAudioAnimationAnalyzerPerformanceTest::RunTest(const FString& Parameters)
+{
+	USkeleton* Skeleton = AudioAnimationAnalyzerTests::CreateSkeleton();
+
+	//Long sequences, so the timings are not dominated by the setup of each analysis. Detection is still checked.
+	for (const int FrameRate : {30, 60, 120})
+	{
+		AudioAnimationAnalyzerTests::TestSequence(*this, Skeleton, FrameRate, 120.0f);
+	}
+
+	return true;
+}
+
+#endif
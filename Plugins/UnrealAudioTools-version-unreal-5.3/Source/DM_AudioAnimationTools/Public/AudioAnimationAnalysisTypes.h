@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioAnimationAnalysisTypes.generated.h"
+
+USTRUCT(BlueprintType)
+struct FFootstepAudioData
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	FName BoneName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float FootstepSpeed;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float FootstepTime;
+
+	/**Time in seconds the foot stays on the ground after the footstep*/
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float ContactDuration = 0.0f;
+};
+
+/**Time range during which a foot touches the ground*/
+USTRUCT(BlueprintType)
+struct FFootContactInterval
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float StartTime = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float EndTime = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FFootstepAudioTrack
+{
+
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	FName TrackName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	FName BoneName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	TArray<FFootstepAudioData> Footsteps;
+
+	/**Every time range the foot touches the ground, including a contact from the start of the animation and the contacts of footsteps filtered out by sensitivity*/
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	TArray<FFootContactInterval> GroundContacts;
+
+	/**Used for debug purposes*/
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float LowestBonePosition;
+
+	/**Used for debug purposes*/
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float HighestBonePosition;
+
+	/**Used for filtering purposes*/
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float FastestBoneSpeed;
+
+	/**Used for filtering purposes*/
+	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
+	float SlowestBoneSpeed;
+};
+
+USTRUCT(BlueprintType)
+struct FFoleyAudioData
+{
+	GENERATED_BODY()
+
+public:
+	
+	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
+	FName BoneName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
+	float FoleySpeed;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
+	float FoleyLength;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
+	float FoleyTime;
+	
+};
+
+USTRUCT(BlueprintType)
+struct FFoleyAudioTrack
+{
+
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
+	FName TrackName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
+	TArray<FFoleyAudioData> FoleyMovements;
+};
+
+UENUM(BlueprintType)
+enum EFootstepDetectionMethod
+{
+	HeightThreshold,
+	TangentCalculation
+};
+
+/**
+ * Detection parameters of the footstep and foley analysis.
+ * The Audio Animation Tools widget fills it from its own settings.
+ */
+USTRUCT(BlueprintType)
+struct FAudioAnimationAnalysisSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/**Height under which a foot is considered to touch the ground*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
+	float GroundContactStartThreshold = 3.0f;
+
+	/**
+	 * Height above the contact at which a foot stops touching the ground, ending its ground contact, in both detection methods.
+	 * Added to the GroundContactStartThreshold with HeightThreshold, and to the height of the foot at each detected contact with TangentCalculation.
+	 * Sets the contact durations, the ground contacts and the contact curves.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
+	float GroundContactStopMargin = 3.0f;
+
+	/**Speed under which any footsteps movements will be ignored*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
+	float FootstepSpeedThreshold = 1.0f;
+
+	/**The time in seconds used to calculate the speed of the foot just before a footstep (to derive its strength)*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
+	float FootstepSpeedCalculationWindow = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
+	TEnumAsByte<EFootstepDetectionMethod> FootstepDetectionMethod = EFootstepDetectionMethod::HeightThreshold;
+
+	/**Footsteps slower than the fastest footstep of their track times (1 - Sensitivity) get no notify*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails", meta = (ClampMin = "0.0", ClampMax ="1.0", UIMin ="0.0", UIMax ="1.0"))
+	float FootstepDetectionSensitivity = 1.0f;
+
+	/**Time in seconds to ignore for footstep notifies on the edges of the animation*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
+	float AnimationEdgesMargin = 0.1f;
+
+	/**In units per second, the speed above which a bone is considered to be moving*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FoleyDetails")
+	float FoleySpeedThreshold = 10.0f;
+
+	/**The time in seconds under which a movement will be considered too short to trigger*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FoleyDetails")
+	float FoleyMinimumMovementDuration = 0.05f;
+
+	/**Should the analysis spam the log with information*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Debug")
+	bool VerboseLogging = false;
+
+	/**Reuse the results of a previous analysis of the same animation data, bones and settings from the derived data cache. Ignored with VerboseLogging.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Debug")
+	bool UseAnalysisCache = true;
+};
+
+/**
+ * What footstep generation writes to the animations.
+ * Sync markers and contact curves are shared by all the animations of a blend, where notifies fire from each of them.
+ */
+USTRUCT(BlueprintType)
+struct FFootstepOutputSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/**One notify per footstep*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepOutput")
+	bool WriteNotifies = true;
+
+	/**One sync marker per footstep, on the "AutoGen Sync Markers" notify track*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepOutput")
+	bool WriteSyncMarkers = false;
+
+	/**Name of the sync marker of each foot bone. Footsteps of bones missing from the map get no marker.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepOutput", meta = (EditCondition = "WriteSyncMarkers"))
+	TMap<FName, FName> SyncMarkerNames = {{TEXT("foot_l"), TEXT("L")}, {TEXT("foot_r"), TEXT("R")}};
+
+	/**One float curve per foot bone, 1 while the foot is on the ground and 0 otherwise*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepOutput")
+	bool WriteContactCurves = false;
+
+	/**Contact curves are named with this prefix followed by the bone name*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepOutput", meta = (EditCondition = "WriteContactCurves"))
+	FString ContactCurvePrefix = TEXT("FootContact_");
+
+	/**Contact phase, foot and intensity of each footstep, stored on the sequence for runtime lookahead (Demute Footstep Timing Data)*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepOutput")
+	bool WriteTimingData = false;
+};
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioAnimationAnalysisTypes.h"
+
+class FAudioAnimationPoseSampler;
+class UAnimSequence;
+class UAnimSequenceBase;
+struct FAnimSegment;
+
+/**
+ * Footstep and foley detection on animation sequences.
+ *
+ * Only reads the sequences it analyzes, so several analyses can run on worker threads at once.
+ * Writing the resulting notifies back to the sequences is left to the game thread.
+ * Results are cached in the derived data cache (see UseAnalysisCache), so unchanged animations are not analyzed again.
+ */
+class DM_AUDIOANIMATIONTOOLS_API FAudioAnimationAnalyzer
+{
+public:
+	explicit FAudioAnimationAnalyzer(const FAudioAnimationAnalysisSettings& InSettings);
+
+	/** Detects the footsteps of each bone, with the detection method of the settings */
+	void AnalyzeFootsteps(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& OutFootstepTracks) const;
+
+	const FAudioAnimationAnalysisSettings& GetSettings() const { return Settings; }
+
+	/** Detects the movements of each bone */
+	void AnalyzeFoley(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, TArray<FFoleyAudioTrack>& OutFoleyTracks) const;
+
+	/**
+	 * Detects the footsteps of the sequences played by a montage (its first slot) or a composite, in montage or composite time.
+	 * A sequence played by several segments is analyzed once. Sequences are analyzed directly.
+	 */
+	void AnalyzeSegmentFootsteps(const UAnimSequenceBase* Animation, const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& OutFootstepTracks) const;
+
+	/** Detects the movements of the sequences played by a montage (its first slot) or a composite, in montage or composite time */
+	void AnalyzeSegmentFoley(const UAnimSequenceBase* Animation, const TArray<FName>& BoneNames, TArray<FFoleyAudioTrack>& OutFoleyTracks) const;
+
+private:
+	/** Resolves the skeleton indexes of the bones, logging the missing ones. False if the sequence can't be analyzed. */
+	static bool FindBones(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, const TCHAR* Caller, TArray<FName>& OutBoneNames, TArray<int>& OutBoneIndexes);
+
+	/** Every bone exists in the skeleton of the sequence. Results missing bones are not cached, so their errors are logged again on the next analysis. */
+	static bool HasAllBones(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames);
+
+	void CalculateFootstepsWithHeightThreshold(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks) const;
+
+	void CalculateFootstepsWithTangents(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks) const;
+
+	/** Segments of a montage (its first slot) or a composite that play an animation sequence */
+	static void GetSequenceSegments(const UAnimSequenceBase* Animation, TArray<const FAnimSegment*>& OutSegments);
+
+	/** Derived data cache key of the analysis, empty if it should not be cached */
+	FString GetCacheKey(const UAnimSequence* AnimationSequence, const TArray<FName>& BoneNames, const TCHAR* Analysis) const;
+
+	/** Analysis sample times: every frame of the animation, at its own sampling frame rate */
+	static void GetSampleTimes(const UAnimSequence* AnimationSequence, TArray<float>& OutTimes);
+
+	/**
+	 * Time the bone height goes down to Height between StartTime, where it is above, and EndTime, where it is below (at EndLocation). By bisection.
+	 * OutLocation is the bone location at the returned time.
+	 */
+	double RefineHeightCrossing(FAudioAnimationPoseSampler& PoseSampler, int SampledBone, double StartTime, double EndTime, const FVector& EndLocation, float Height, FVector& OutLocation) const;
+
+	/** Time of the lowest bone height between StartTime and EndTime, by golden section search. OutLocation is the bone location at the returned time. */
+	double RefineLowestHeight(FAudioAnimationPoseSampler& PoseSampler, int SampledBone, double StartTime, double EndTime, FVector& OutLocation) const;
+
+	FAudioAnimationAnalysisSettings Settings;
+
+	/** Sample interval the speed thresholds were tuned for, before sampling at the animation frame rate */
+	const float ReferenceTimeIncrement = 1.0f / 60.0f;
+
+	/** Contacts are refined between two frames until known within this time */
+	const double ContactTimeTolerance = 0.0005;
+};
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AudioAnimationAnalysisTypes.h"
+#include "AudioAnimationNotifyCommandlet.generated.h"
+
+class UAnimNotify;
+class UAnimSequence;
+
+/**
+ * Generates footstep and foley notifies on every animation sequence under content paths, without the editor UI.
+ * Same detection as the Audio Animation Tools widget. Only the modified packages are saved.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=AudioAnimationNotify -Paths=/Game/Animations [options]
+ *
+ * Options:
+ *   -Paths=<Path+Path>             Content paths searched recursively for animation sequences
+ *   -FootstepBones=<Bone,Bone>     Bones to detect footsteps on
+ *   -FootstepNotify=<ClassPath>    Notify class of the footsteps (e.g. /Game/Audio/AN_Footstep.AN_Footstep_C). No footstep notifies without it.
+ *   -SyncMarkers=<Bone:Marker,...> Writes a sync marker per footstep (e.g. foot_l:L,foot_r:R)
+ *   -ContactCurves[=<Prefix>]      Writes a foot contact curve per foot bone (prefix FootContact_ by default)
+ *   -TimingData                    Writes the footstep timing data of the sequence, for runtime lookahead
+ *   -FoleyBones=<Bone,Bone>        Bones to detect foley movements on
+ *   -FoleyNotify=<ClassPath>       Notify class of the foley movements
+ *   -Method=<HeightThreshold|TangentCalculation>
+ *   -GroundContactStartThreshold= -GroundContactStopMargin= -FootstepSpeedThreshold= -FootstepSpeedCalculationWindow=
+ *   -FootstepDetectionSensitivity= -AnimationEdgesMargin= -FoleySpeedThreshold= -FoleyMinimumMovementDuration=
+ *                                  Detection settings, widget defaults otherwise
+ *   -BatchSize=<N>                 Sequences loaded and analyzed in parallel at once (default 64)
+ *   -Report=<File>                 Writes a CSV line per sequence
+ *   -DryRun                        Analyzes and reports without saving
+ *   -NoCache                       Analyzes every sequence again instead of reusing the cached results
+ */
+UCLASS()
+class DM_AUDIOANIMATIONTOOLS_API UAudioAnimationNotifyCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAudioAnimationNotifyCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Analysis result of one sequence, for the report */
+	struct FSequenceReport
+	{
+		FString PackageName;
+		int NumFootsteps = 0;
+		int NumFoleyMovements = 0;
+		bool bModified = false;
+		bool bSaved = false;
+		FString Error;
+	};
+
+	/** Reads the detection settings from the command line */
+	static FAudioAnimationAnalysisSettings ParseSettings(const FString& Params);
+
+	/** Reads the footstep outputs from the command line. Notifies are written if there is a notify class. */
+	static FFootstepOutputSettings ParseFootstepOutput(const FString& Params, bool bHasNotifyClass);
+
+	static TSubclassOf<UAnimNotify> LoadNotifyClass(const FString& Params, const TCHAR* Switch);
+
+	static bool SavePackage(UPackage* Package, FString& OutError);
+
+	static void WriteReport(const FString& ReportFile, const TArray<FSequenceReport>& Reports);
+};
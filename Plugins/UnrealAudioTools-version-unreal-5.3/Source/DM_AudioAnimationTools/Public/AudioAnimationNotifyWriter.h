@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioAnimationAnalysisTypes.h"
+#include "Templates/SubclassOf.h"
+
+class UAnimNotify;
+class UAnimSequence;
+class UAnimSequenceBase;
+
+/**
+ * Writes analyzed tracks back to an animation as notifies, sync markers or curves. Game thread only.
+ * Each track replaces the notifies of the notify track with the same name, from a previous generation.
+ * Tracks whose notifies would come out the same are left untouched, so re-running an analysis doesn't dirty the animation.
+ */
+class DM_AUDIOANIMATIONTOOLS_API FAudioAnimationNotifyWriter
+{
+public:
+	/**
+	 * Replaces the notifies of the footstep tracks, filtered by sensitivity and animation edges. Returns true if the animation was modified.
+	 * Also writes montages and composites, whose notifies are linked to the segment playing at their time.
+	 */
+	static bool WriteFootstepNotifies(UAnimSequenceBase* AnimationSequence, TArray<FFootstepAudioTrack>& FootstepTracks, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                                  const FAudioAnimationAnalysisSettings& Settings, TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies);
+
+	/**Writes the footstep tracks with every output of OutputSettings: notifies, sync markers and contact curves. Returns true if the animation was modified.*/
+	static bool WriteFootsteps(UAnimSequence* AnimationSequence, TArray<FFootstepAudioTrack>& FootstepTracks, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                           const FAudioAnimationAnalysisSettings& Settings, const FFootstepOutputSettings& OutputSettings, TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies);
+
+	/**
+	 * Replaces the sync markers of the "AutoGen Sync Markers" track with one marker per footstep, named from SyncMarkerNames by bone.
+	 * Filtered by sensitivity only. Returns true if the animation was modified.
+	 */
+	static bool WriteFootstepSyncMarkers(UAnimSequence* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	                                     const FAudioAnimationAnalysisSettings& Settings, const TMap<FName, FName>& SyncMarkerNames);
+
+	/**The sync markers WriteFootstepSyncMarkers writes, as time and name pairs sorted by time*/
+	static void GetFootstepSyncMarkers(const UAnimSequenceBase* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	                                   const FAudioAnimationAnalysisSettings& Settings, const TMap<FName, FName>& SyncMarkerNames, TArray<TPair<float, FName>>& OutMarkers);
+
+	/**
+	 * Checks that the sequences of a blend (e.g. the samples of a blend space) get the same sync markers in the same order over their cycle,
+	 * as WriteFootstepSyncMarkers writes them. Blended sync markers only line up between sequences that do.
+	 * Only reports: logs the differences, Context naming the blend, and changes nothing.
+	 */
+	static bool HaveConsistentSyncMarkers(TConstArrayView<const UAnimSequence*> Sequences, TConstArrayView<TArray<FFootstepAudioTrack>> SequenceFootstepTracks,
+	                                      const FAudioAnimationAnalysisSettings& Settings, const TMap<FName, FName>& SyncMarkerNames, const FString& Context);
+
+	/**
+	 * Sets a float curve per foot, ContactCurvePrefix + bone name, at 1 while the foot is on the ground and 0 otherwise.
+	 * Built from the ground contacts of the tracks, not filtered by sensitivity. Returns true if the animation was modified.
+	 */
+	static bool WriteFootstepContactCurves(UAnimSequence* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	                                       const FString& ContactCurvePrefix);
+
+	/**
+	 * Replaces the footstep timing data of the animation (Demute Footstep Timing Data asset user data) with the footsteps of all tracks,
+	 * filtered by sensitivity and animation edges like the notifies. Returns true if the animation was modified.
+	 */
+	static bool WriteFootstepTimingData(UAnimSequenceBase* AnimationSequence, const TArray<FFootstepAudioTrack>& FootstepTracks,
+	                                    const FAudioAnimationAnalysisSettings& Settings);
+
+	/**Replaces the notifies of the foley tracks, on a sequence, montage or composite. Returns true if the animation was modified.*/
+	static bool WriteFoleyNotifies(UAnimSequenceBase* AnimationSequence, TArray<FFoleyAudioTrack>& FoleyTracks, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                               TMap<UAnimNotify*, FFoleyAudioData>& CreatedNotifies);
+};
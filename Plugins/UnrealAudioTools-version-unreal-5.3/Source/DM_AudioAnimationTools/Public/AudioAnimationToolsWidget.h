@@ -4,95 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "AudioAnimationAnalysisTypes.h"
 #include "AudioAnimationToolsWidget.generated.h"
 
-USTRUCT(BlueprintType)
-struct FFootstepAudioData
-{
-	GENERATED_BODY()
-
-public:
-
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	FName BoneName;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	float FootstepSpeed;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	float FootstepTime;
-};
-
-USTRUCT(BlueprintType)
-struct FFootstepAudioTrack
-{
-
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	FName TrackName;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	TArray<FFootstepAudioData> Footsteps;
-
-	/**Used for debug purposes*/
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	float LowestBonePosition;
-
-	/**Used for debug purposes*/
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	float HighestBonePosition;
-
-	/**Used for filtering purposes*/
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	float FastestBoneSpeed;
-
-	/**Used for filtering purposes*/
-	UPROPERTY(BlueprintReadOnly, Category = "Footstep Audio Data")
-	float SlowestBoneSpeed;
-};
-
-USTRUCT(BlueprintType)
-struct FFoleyAudioData
-{
-	GENERATED_BODY()
-
-public:
-	
-	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
-	FName BoneName;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
-	float FoleySpeed;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
-	float FoleyLength;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
-	float FoleyTime;
-	
-};
-
-USTRUCT(BlueprintType)
-struct FFoleyAudioTrack
-{
-
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
-	FName TrackName;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Foley Audio Data")
-	TArray<FFoleyAudioData> FoleyMovements;
-};
-
-UENUM(BlueprintType)
-enum EFootstepDetectionMethod
-{
-	HeightThreshold,
-	TangentCalculation
-};
-
+class UBlendSpace;
 
 /**
  * 
@@ -112,13 +27,70 @@ public:
 	void AutoGenerateFoleyNotifies(UAnimSequence* AnimationSequence, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass, TMap<UAnimNotify*,
 	                               FFoleyAudioData>& CreatedNotifies, TArray<FFoleyAudioTrack>& CreatedTracks);
 
+	/**
+	 * Generates footstep notifies on many animations. The analysis runs on worker threads behind a progress dialog,
+	 * then the notifies are written on the game thread.
+	 * @return False if cancelled. Animations analyzed before cancelling still get their notifies.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Animation Tools Widget")
+	bool AutoGenerateFootstepNotifiesBatch(const TArray<UAnimSequence*>& AnimationSequences, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                                       TArray<UAnimSequence*>& ModifiedSequences);
+
+	/**
+	 * Generates foley notifies on many animations. The analysis runs on worker threads behind a progress dialog,
+	 * then the notifies are written on the game thread.
+	 * @return False if cancelled. Animations analyzed before cancelling still get their notifies.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Animation Tools Widget")
+	bool AutoGenerateFoleyNotifiesBatch(const TArray<UAnimSequence*>& AnimationSequences, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                                    TArray<UAnimSequence*>& ModifiedSequences);
+
+	/**
+	 * Generates footsteps on every sample animation of a blend space, each sequence being analyzed once.
+	 * ConsistentPhases tells whether all samples get the same sync markers in the same order, which blended sync markers need.
+	 * It is only a check: inconsistent samples are logged and written as they are, fix their contacts or sensitivity by hand.
+	 * @return False if cancelled. Animations analyzed before cancelling still get their footsteps.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Animation Tools Widget")
+	bool AutoGenerateFootstepNotifiesForBlendSpace(UBlendSpace* BlendSpace, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                                               TArray<UAnimSequence*>& ModifiedSequences, bool& ConsistentPhases);
+
+	/**
+	 * Generates foley notifies on every sample animation of a blend space, each sequence being analyzed once.
+	 * @return False if cancelled. Animations analyzed before cancelling still get their notifies.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Animation Tools Widget")
+	bool AutoGenerateFoleyNotifiesForBlendSpace(UBlendSpace* BlendSpace, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                                            TArray<UAnimSequence*>& ModifiedSequences);
+
+	/**
+	 * Generates footstep notifies on a montage (from the sequences of its first slot) or a composite, in montage time.
+	 * Sync markers and contact curves stay on the sequences: generate them there.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Animation Tools Widget")
+	void AutoGenerateFootstepNotifiesForMontage(UAnimSequenceBase* MontageOrComposite, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                                            TMap<UAnimNotify*, FFootstepAudioData>& CreatedNotifies, TArray<FFootstepAudioTrack>& CreatedTracks);
+
+	/**Generates foley notifies on a montage (from the sequences of its first slot) or a composite, in montage time*/
+	UFUNCTION(BlueprintCallable, Category = "Audio Animation Tools Widget")
+	void AutoGenerateFoleyNotifiesForMontage(UAnimSequenceBase* MontageOrComposite, TArray<FName> BoneNames, TSubclassOf<UAnimNotify> AnimNotifyClass,
+	                                         TMap<UAnimNotify*, FFoleyAudioData>& CreatedNotifies, TArray<FFoleyAudioTrack>& CreatedTracks);
+
+	/**Detection settings of the analysis, from the widget settings*/
+	UFUNCTION(BlueprintPure, Category = "Audio Animation Tools Widget")
+	FAudioAnimationAnalysisSettings GetAnalysisSettings() const;
+
 	//User modifiable variables
 	/**Height under which a foot is considered to touch the ground*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails", meta = (EditCondition = "FootstepDetectionMethod == EFootstepDetectionMethod::HeightThreshold"))
 	float GroundContactStartThreshold = 3.0f;
 
-	/**Height added to the GroundContactStartThreshold above which a foot is considered to not touch the ground anymore*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails", meta = (EditCondition = "FootstepDetectionMethod == EFootstepDetectionMethod::HeightThreshold"))
+	/**
+	 * Height above the contact at which a foot stops touching the ground, ending its ground contact, in both detection methods.
+	 * Added to the GroundContactStartThreshold with HeightThreshold, and to the height of the foot at each detected contact with TangentCalculation.
+	 * Sets the contact durations, the ground contacts and the contact curves.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
 	float GroundContactStopMargin = 3.0f;
 
 	/**Speed under which any footsteps movements will be ignored*/
@@ -163,26 +135,31 @@ public:
 	UPROPERTY(EditAnywhere, Category="Debug")
 	bool VerboseLogging = false;
 
+	/**Reuse the results of previous analyses of unchanged animations with the same bones and settings*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Debug")
+	bool UseAnalysisCache = true;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepDetails")
 	TEnumAsByte<EFootstepDetectionMethod> FootstepDetectionMethod = EFootstepDetectionMethod::HeightThreshold;
+
+	/**What footstep generation writes: notifies, sync markers for blended locomotion, foot contact curves*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FootstepOutput")
+	FFootstepOutputSettings FootstepOutput;
 	
 	
 private:
 
-	//System variables
-	const float AnimationTimeIncrement = 1.0f / 60.0f;
-
-	void CalculateFootstepsWithHeightThreshold(UAnimSequence* AnimationSequence, TArray<FName> BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks);
-	
-	void CalculateFootstepsWithTangents(UAnimSequence* AnimationSequence, TArray<FName> BoneNames, TArray<FFootstepAudioTrack>& FootstepTracks);
-	
 	//System methods
-	static int GetAnimationTrackIndex(int SkeletonBoneIndex, const UAnimSequence* AnimSequence);
+	/**Analyzed footstep tracks of each animation, on worker threads behind a progress dialog. Returns false if cancelled.*/
+	bool AnalyzeFootstepsBatch(const TArray<UAnimSequence*>& AnimationSequences, const TArray<FName>& BoneNames, TArray<TArray<FFootstepAudioTrack>>& OutAnimationTracks,
+	                           TArray<bool>& OutAnalyzed) const;
 
-	static FVector GetBoneLocation(const UAnimSequence* AnimSequence, const FReferenceSkeleton& ReferenceSkeleton, int BoneIndex, float Time);
+	/**Analyzed foley tracks of each animation, on worker threads behind a progress dialog. Returns false if cancelled.*/
+	bool AnalyzeFoleyBatch(const TArray<UAnimSequence*>& AnimationSequences, const TArray<FName>& BoneNames, TArray<TArray<FFoleyAudioTrack>>& OutAnimationTracks,
+	                       TArray<bool>& OutAnalyzed) const;
 
-	static void GetWorldToRootTransform(const UAnimSequence* AnimSequence, const double Time, FTransform& OutTransform);
+	/**Sequences of the blend space samples, once each*/
+	static TArray<UAnimSequence*> GetBlendSpaceSequences(const UBlendSpace* BlendSpace);
 
-	static void GetRootToBoneTransform(const UAnimSequence* AnimSequence, const FReferenceSkeleton& ReferenceSkeleton, const int BoneIndex, const double Time, FTransform
-	                                   & OutTransform);
+	static int GetAnimationTrackIndex(int SkeletonBoneIndex, const UAnimSequence* AnimSequence);
 };
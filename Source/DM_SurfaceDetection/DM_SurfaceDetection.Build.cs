@@ -21,7 +21,7 @@ public class DM_SurfaceDetection : ModuleRules
 			"Slate"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { });
+		PrivateDependencyModuleNames.AddRange(new string[] { "DM_SurfaceDetector" });
 
 		PublicIncludePaths.AddRange(new string[] {
 			"DM_SurfaceDetection",
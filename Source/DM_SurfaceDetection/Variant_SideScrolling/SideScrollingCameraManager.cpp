@@ -2,6 +2,7 @@
 
 
 #include "SideScrollingCameraManager.h"
+#include "DemuteGroundProbeComponent.h"
 #include "GameFramework/Pawn.h"
 #include "Engine/HitResult.h"
 #include "CollisionQueryParams.h"
@@ -55,6 +56,14 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 			// determine if we need to do a height update
 			bZUpdate = FMath::IsNearlyEqual(CurrentZ, CurrentCameraLocation.Z, 25.0f);
 
+		} else if (UDemuteGroundProbeComponent* GroundProbe = TargetPawn->FindComponentByClass<UDemuteGroundProbeComponent>()) {
+
+			// reuse the ground probed below the character this frame
+			const FDemuteGroundHit& Ground = GroundProbe->GetGround();
+
+			// only update height if we're not about to hit ground
+			bZUpdate = !Ground.bHit || Ground.Distance > 1000.0f;
+
 		} else {
 
 			// run a trace below the character to determine if we need to do a height update
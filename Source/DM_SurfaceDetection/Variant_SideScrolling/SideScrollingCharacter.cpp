@@ -5,6 +5,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Camera/CameraComponent.h"
+#include "DemuteGroundProbeComponent.h"
 #include "Components/InputComponent.h"
 #include "InputActionValue.h"
 #include "EnhancedInputComponent.h"
@@ -24,6 +25,9 @@ ASideScrollingCharacter::ASideScrollingCharacter()
 
 	Camera->SetRelativeLocationAndRotation(FVector(0.0f, 300.0f, 0.0f), FRotator(0.0f, -90.0f, 0.0f));
 
+	// create the ground probe
+	GroundProbe = CreateDefaultSubobject<UDemuteGroundProbeComponent>(TEXT("Ground Probe"));
+
 	// configure the collision capsule
 	GetCapsuleComponent()->SetCapsuleSize(35.0f, 90.0f);
 
@@ -305,7 +309,8 @@ void ASideScrollingCharacter::CheckForSoftCollision()
 	// reset the drop value
 	DropValue = 0.0f;
 
-	// trace down 
+	// trace down for soft floors only. This runs on the drop input alone, and the ground probe's
+	// channel trace could miss a platform ignoring that channel, or hit something else first
 	FHitResult OutHit;
 
 	const FVector Start = GetActorLocation();
@@ -7,6 +7,7 @@
 #include "SideScrollingCharacter.generated.h"
 
 class UCameraComponent;
+class UDemuteGroundProbeComponent;
 class UInputAction;
 struct FInputActionValue;
 
@@ -22,6 +23,10 @@ class ASideScrollingCharacter : public ACharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Camera", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* Camera;
 
+	/** Shared downward query, used by the camera and footsteps */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UDemuteGroundProbeComponent* GroundProbe;
+
 protected:
 
 	/** Move Input Action */